@@ -0,0 +1,115 @@
+#include <SFML/Graphics/Rect.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../GexEngine/AabbBatch.h"
+
+// Times AabbBatch against sf::Rect::intersects on the same boxes: every box is
+// tested against every later one, the way LaneSweep walks a lane, and both
+// sides must find the same number of overlaps. Build Release to measure:
+//
+//   AabbBench [seed]        default seed 1
+
+namespace {
+    // cars and pickups sized boxes spread over a 1280x768 viewport
+    std::vector<sf::FloatRect> makeBoxes(size_t count, std::uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> x(0.f, 1280.f);
+        std::uniform_real_distribution<float> y(0.f, 768.f);
+        std::uniform_real_distribution<float> size(20.f, 120.f);
+
+        std::vector<sf::FloatRect> boxes;
+        boxes.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            boxes.emplace_back(x(rng), y(rng), size(rng), size(rng));
+        return boxes;
+    }
+
+    std::uint64_t countScalar(const std::vector<sf::FloatRect>& boxes) {
+        std::uint64_t hits = 0;
+        for (size_t i = 0; i < boxes.size(); ++i)
+            for (size_t j = i + 1; j < boxes.size(); ++j)
+                hits += boxes[i].intersects(boxes[j]);
+        return hits;
+    }
+
+    std::uint64_t countBatch(const std::vector<sf::FloatRect>& boxes, const AabbBatch& batch) {
+        std::uint64_t hits = 0;
+        for (size_t i = 0; i < boxes.size(); ++i)
+            batch.forEachOverlap(boxes[i], i + 1, boxes.size(), [&](size_t) { ++hits; });
+        return hits;
+    }
+
+    // best of a few rounds, each repeated until it takes long enough to time
+    template<typename F>
+    double nanosecondsPerPair(size_t count, F&& run, std::uint64_t& hits) {
+        using Clock = std::chrono::steady_clock;
+        const double pairs = count * (count - 1) / 2.0;
+        double best = 0.0;
+        for (int round = 0; round < 5; ++round) {
+            int repeats = 0;
+            auto start = Clock::now();
+            std::chrono::duration<double, std::nano> elapsed{};
+            do {
+                hits = run();
+                ++repeats;
+                elapsed = Clock::now() - start;
+            } while (elapsed.count() < 20e6);
+
+            double perPair = elapsed.count() / repeats / pairs;
+            if (round == 0 || perPair < best)
+                best = perPair;
+        }
+        return best;
+    }
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::uint32_t seed = argc > 1 ? static_cast<std::uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 1;
+
+#if defined(__AVX2__)
+    const char* kernel = "AVX2";
+#elif defined(__AVX__)
+    const char* kernel = "AVX";
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    const char* kernel = "SSE2";
+#else
+    const char* kernel = "scalar";
+#endif
+    std::cout << "AabbBatch kernel: " << kernel << ", seed " << seed << "\n\n";
+    std::cout << std::setw(8) << "boxes" << std::setw(12) << "overlaps"
+        << std::setw(14) << "scalar ns" << std::setw(14) << "batch ns" << std::setw(10) << "speedup" << "\n";
+
+    int failures = 0;
+    for (size_t count : { 100, 1000, 10000 }) {
+        std::vector<sf::FloatRect> boxes = makeBoxes(count, seed);
+        AabbBatch batch;
+        batch.reserve(boxes.size());
+        for (const auto& box : boxes)
+            batch.push(box);
+
+        std::uint64_t scalarHits = 0;
+        std::uint64_t batchHits = 0;
+        double scalar = nanosecondsPerPair(count, [&] { return countScalar(boxes); }, scalarHits);
+        double batched = nanosecondsPerPair(count, [&] { return countBatch(boxes, batch); }, batchHits);
+
+        std::cout << std::fixed << std::setprecision(3)
+            << std::setw(8) << count << std::setw(12) << scalarHits
+            << std::setw(14) << scalar << std::setw(14) << batched
+            << std::setprecision(2) << std::setw(9) << scalar / batched << "x" << "\n";
+
+        if (scalarHits != batchHits) {
+            std::cerr << "Mismatch at " << count << " boxes: scalar " << scalarHits << ", batch " << batchHits << "\n";
+            ++failures;
+        }
+    }
+
+    std::cout << "\nns are per box pair tested" << std::endl;
+    return failures > 0 ? 1 : 0;
+}
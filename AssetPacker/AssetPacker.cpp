@@ -0,0 +1,122 @@
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../GexEngine/AssetPack.h"
+
+// Bakes config.txt and every font, texture and sound it names into one pack
+// that the game maps at startup. Asset paths in the config are relative, so
+// run it from the same directory the game runs from:
+//
+//   AssetPacker [config] [pack]        defaults: ../config.txt ../assets.pack
+
+namespace {
+    bool readFile(const std::string& path, std::string& bytes) {
+        std::ifstream file(path, std::ios::binary);
+        if (file.fail())
+            return false;
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    bool packFont(AssetPackWriter& pack, const std::string& path) {
+        std::string bytes;
+        if (!readFile(path, bytes))
+            return false;
+        pack.add(AssetPack::Type::Font, path, bytes.data(), bytes.size());
+        return true;
+    }
+
+    bool packTexture(AssetPackWriter& pack, const std::string& path) {
+        sf::Image image;
+        if (!image.loadFromFile(path))
+            return false;
+        auto size = image.getSize();
+        pack.add(AssetPack::Type::Texture, path, image.getPixelsPtr(),
+            static_cast<std::uint64_t>(size.x) * size.y * 4, size.x, size.y);
+        return true;
+    }
+
+    bool packSound(AssetPackWriter& pack, const std::string& path) {
+        sf::InputSoundFile file;
+        if (!file.openFromFile(path))
+            return false;
+        std::vector<sf::Int16> samples(static_cast<size_t>(file.getSampleCount()));
+        samples.resize(static_cast<size_t>(file.read(samples.data(), samples.size())));
+        if (samples.empty())
+            return false;
+        pack.add(AssetPack::Type::Sound, path, samples.data(), samples.size() * sizeof(sf::Int16),
+            file.getChannelCount(), file.getSampleRate());
+        return true;
+    }
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::string configPath = argc > 1 ? argv[1] : "../config.txt";
+    std::string packPath = argc > 2 ? argv[2] : "../assets.pack";
+
+    std::string config;
+    if (!readFile(configPath, config)) {
+        std::cerr << "Open file " << configPath << " failed\n";
+        return 1;
+    }
+
+    // written next to the target and renamed at the end, a running game keeps its old mapping
+    std::string tempPath = packPath + ".tmp";
+    AssetPackWriter pack;
+    if (!pack.open(tempPath)) {
+        std::cerr << "Failed to create " << tempPath << "\n";
+        return 1;
+    }
+    pack.add(AssetPack::Type::Config, AssetPackFormat::ConfigName, config.data(), config.size());
+
+    std::set<std::string> packed;
+    int failures = 0;
+
+    std::istringstream lines(config);
+    std::string line;
+    while (std::getline(lines, line)) {
+        std::istringstream iss(line);
+        std::string token, name, path;
+        iss >> token >> name >> path;
+        if (token != "Font" && token != "Texture" && token != "Sound")
+            continue;
+        if (!packed.insert(path).second)
+            continue;
+
+        bool ok = (token == "Font") ? packFont(pack, path)
+            : (token == "Texture") ? packTexture(pack, path)
+            : packSound(pack, path);
+        if (!ok) {
+            std::cerr << "Failed to pack " << token << " " << path << "\n";
+            ++failures;
+            continue;
+        }
+        std::cout << "Packed " << token << ": " << name << " from " << path << std::endl;
+    }
+
+    std::error_code ec;
+    if (!pack.finish() || failures > 0) {
+        std::cerr << "Pack not written, " << failures << " assets failed\n";
+        std::filesystem::remove(tempPath, ec);
+        return 1;
+    }
+
+    std::filesystem::rename(tempPath, packPath, ec);
+    if (ec) {
+        std::cerr << "Failed to replace " << packPath << ": " << ec.message() << "\n";
+        return 1;
+    }
+
+    std::cout << "Wrote " << pack.getEntryCount() << " entries, " << pack.getSize() / (1024 * 1024)
+        << " MB to " << packPath << std::endl;
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "AabbBatch.h"
+#include <algorithm>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define AABB_BATCH_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AABB_BATCH_SSE
+#endif
+
+void AabbBatch::reserve(size_t count) {
+    m_minX.reserve(count + Width);
+    m_minY.reserve(count + Width);
+    m_maxX.reserve(count + Width);
+    m_maxY.reserve(count + Width);
+}
+
+void AabbBatch::push(const sf::FloatRect& box) {
+    // a block may start at any index below m_count, so the arrays keep Width
+    // slots of slack past it and the vector loads never run off the end
+    if (m_count + 1 + Width > m_minX.size()) {
+        size_t size = std::max(m_minX.size() * 2, m_count + 1 + Width);
+        m_minX.resize(size, 0.f);
+        m_minY.resize(size, 0.f);
+        m_maxX.resize(size, 0.f);
+        m_maxY.resize(size, 0.f);
+    }
+
+    m_minX[m_count] = box.left;
+    m_minY[m_count] = box.top;
+    m_maxX[m_count] = box.left + box.width;
+    m_maxY[m_count] = box.top + box.height;
+    ++m_count;
+}
+
+std::uint32_t AabbBatch::overlapMask(const sf::FloatRect& rect, size_t first) const {
+    if (first >= m_count)
+        return 0;
+
+    const float rMinX = rect.left;
+    const float rMinY = rect.top;
+    const float rMaxX = rect.left + rect.width;
+    const float rMaxY = rect.top + rect.height;
+
+    std::uint32_t mask = 0;
+
+#if defined(AABB_BATCH_AVX)
+    __m256 hit = _mm256_and_ps(
+        _mm256_and_ps(
+            _mm256_cmp_ps(_mm256_loadu_ps(&m_minX[first]), _mm256_set1_ps(rMaxX), _CMP_LT_OQ),
+            _mm256_cmp_ps(_mm256_set1_ps(rMinX), _mm256_loadu_ps(&m_maxX[first]), _CMP_LT_OQ)),
+        _mm256_and_ps(
+            _mm256_cmp_ps(_mm256_loadu_ps(&m_minY[first]), _mm256_set1_ps(rMaxY), _CMP_LT_OQ),
+            _mm256_cmp_ps(_mm256_set1_ps(rMinY), _mm256_loadu_ps(&m_maxY[first]), _CMP_LT_OQ)));
+    mask = static_cast<std::uint32_t>(_mm256_movemask_ps(hit));
+#elif defined(AABB_BATCH_SSE)
+    const __m128 maxX = _mm_set1_ps(rMaxX);
+    const __m128 minX = _mm_set1_ps(rMinX);
+    const __m128 maxY = _mm_set1_ps(rMaxY);
+    const __m128 minY = _mm_set1_ps(rMinY);
+    for (size_t half = 0; half < Width; half += 4) {
+        size_t i = first + half;
+        __m128 hit = _mm_and_ps(
+            _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(&m_minX[i]), maxX), _mm_cmplt_ps(minX, _mm_loadu_ps(&m_maxX[i]))),
+            _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(&m_minY[i]), maxY), _mm_cmplt_ps(minY, _mm_loadu_ps(&m_maxY[i]))));
+        mask |= static_cast<std::uint32_t>(_mm_movemask_ps(hit)) << half;
+    }
+#else
+    for (size_t b = 0; b < Width; ++b) {
+        size_t i = first + b;
+        bool hit = m_minX[i] < rMaxX && rMinX < m_maxX[i]
+            && m_minY[i] < rMaxY && rMinY < m_maxY[i];
+        mask |= static_cast<std::uint32_t>(hit) << b;
+    }
+#endif
+
+    size_t valid = m_count - first;
+    if (valid < Width)
+        mask &= (1u << valid) - 1;
+    return mask;
+}
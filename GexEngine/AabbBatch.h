@@ -0,0 +1,46 @@
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+#include <cstdint>
+#include <bit>
+
+// Boxes stored as four float arrays so one rect can be tested against
+// Width boxes per instruction (AVX, or two SSE halves, scalar otherwise).
+// The x86 and x64 builds are compiled with /arch:AVX2, ARM64 runs the scalar
+// loop. Same strict-overlap rule as sf::Rect::intersects, for non-negative
+// sizes; AabbBench times it against that.
+class AabbBatch {
+private:
+    std::vector<float> m_minX;
+    std::vector<float> m_minY;
+    std::vector<float> m_maxX;
+    std::vector<float> m_maxY;
+    size_t m_count{ 0 };
+
+public:
+    static constexpr size_t Width = 8;
+
+    void clear() { m_count = 0; }
+    void reserve(size_t count);
+    void push(const sf::FloatRect& box);
+    size_t size() const { return m_count; }
+
+    // bit i is set when rect overlaps box first + i, for any first; boxes past
+    // size() never hit
+    std::uint32_t overlapMask(const sf::FloatRect& rect, size_t first) const;
+
+    // calls onHit(index) for every box in [first, last) overlapping rect
+    template<typename F>
+    void forEachOverlap(const sf::FloatRect& rect, size_t first, size_t last, F&& onHit) const {
+        for (size_t block = first; block < last; block += Width) {
+            std::uint32_t mask = overlapMask(rect, block);
+            if (last - block < Width)
+                mask &= (1u << (last - block)) - 1;
+
+            while (mask) {
+                onHit(block + std::countr_zero(mask));
+                mask &= mask - 1;
+            }
+        }
+    }
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Small integer handle into one of the Assets tables. Resolve it by name once,
+// e.g. TextureId bone = assets.textureId("bone"), then every lookup is an index.
+template<typename Tag>
+struct AssetId {
+    static constexpr std::uint32_t Invalid = 0xFFFFFFFFu;
+
+    std::uint32_t index{ Invalid };
+
+    bool isValid() const { return index != Invalid; }
+    bool operator==(const AssetId& other) const { return index == other.index; }
+    bool operator!=(const AssetId& other) const { return index != other.index; }
+};
+
+using TextureId = AssetId<struct TextureTag>;
+using FontId    = AssetId<struct FontTag>;
+using SoundId   = AssetId<struct SoundTag>;
+
+
+// Dense storage indexed by AssetId, names are only kept for resolving ids and
+// for messages. Items are added while the config is read; adding can move the
+// existing items, so nothing may point at them before loading has finished.
+template<typename Id, typename T>
+class AssetTable {
+private:
+    std::vector<T>                                  m_items;
+    std::vector<std::string>                        m_names;
+    std::unordered_map<std::string, std::uint32_t>  m_ids;
+
+public:
+    // the existing id when the name is already known
+    Id add(const std::string& name) {
+        auto found = m_ids.find(name);
+        if (found != m_ids.end())
+            return Id{ found->second };
+
+        auto index = static_cast<std::uint32_t>(m_items.size());
+        m_items.emplace_back();
+        m_names.push_back(name);
+        m_ids.emplace(name, index);
+        return Id{ index };
+    }
+
+    // invalid id for unknown names
+    Id find(const std::string& name) const {
+        auto found = m_ids.find(name);
+        return found == m_ids.end() ? Id{} : Id{ found->second };
+    }
+
+    bool contains(Id id) const                  { return id.index < m_items.size(); }
+    T& operator[](Id id)                        { return m_items[id.index]; }
+    const T& operator[](Id id) const            { return m_items[id.index]; }
+    const std::string& getName(Id id) const     { return m_names[id.index]; }
+    size_t size() const                         { return m_items.size(); }
+};
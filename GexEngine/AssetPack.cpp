@@ -0,0 +1,218 @@
+#include "AssetPack.h"
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    template<typename T>
+    bool readPod(const std::uint8_t*& cursor, const std::uint8_t* end, T& value) {
+        if (static_cast<size_t>(end - cursor) < sizeof(T))
+            return false;
+        std::memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+    }
+
+    template<typename T>
+    void writePod(std::ofstream& out, T value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+}
+
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+
+bool AssetPack::isPack(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(AssetPackFormat::Magic)] = {};
+    file.read(magic, sizeof(magic));
+    return file && std::memcmp(magic, AssetPackFormat::Magic, sizeof(magic)) == 0;
+}
+
+
+bool AssetPack::open(const std::string& path) {
+    close();
+    if (!map(path)) {
+        std::cerr << "Failed to map asset pack " << path << "\n";
+        close();
+        return false;
+    }
+    if (!readIndex()) {
+        std::cerr << "Asset pack " << path << " is damaged or from another version\n";
+        close();
+        return false;
+    }
+    m_path = path;
+    return true;
+}
+
+
+void AssetPack::close() {
+#ifdef _WIN32
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mapping)
+        CloseHandle(m_mapping);
+    if (m_file)
+        CloseHandle(m_file);
+#else
+    if (m_data)
+        munmap(const_cast<std::uint8_t*>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_file = nullptr;
+    m_size = 0;
+    m_path.clear();
+    m_entries.clear();
+}
+
+
+const AssetPack::Entry* AssetPack::find(Type type, const std::string& name) const {
+    auto found = m_entries.find(name);
+    if (found == m_entries.end() || found->second.type != type)
+        return nullptr;
+    return &found->second;
+}
+
+
+bool AssetPack::map(const std::string& path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    m_file = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+        return false;
+    m_size = static_cast<std::uint64_t>(size.QuadPart);
+
+    m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mapping)
+        return false;
+    m_data = static_cast<const std::uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    return m_data != nullptr;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // the mapping keeps the file alive, the descriptor isn't needed past this
+    void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+        return false;
+
+    m_data = static_cast<const std::uint8_t*>(data);
+    m_size = static_cast<std::uint64_t>(info.st_size);
+    return true;
+#endif
+}
+
+
+bool AssetPack::readIndex() {
+    const std::uint8_t* end = m_data + m_size;
+    const std::uint8_t* cursor = m_data;
+
+    char magic[sizeof(AssetPackFormat::Magic)];
+    std::uint32_t version, count;
+    std::uint64_t indexOffset;
+    if (!readPod(cursor, end, magic) || std::memcmp(magic, AssetPackFormat::Magic, sizeof(magic)) != 0
+        || !readPod(cursor, end, version) || version != AssetPackFormat::Version
+        || !readPod(cursor, end, count) || !readPod(cursor, end, indexOffset)
+        || indexOffset < AssetPackFormat::HeaderSize || indexOffset > m_size)
+        return false;
+
+    cursor = m_data + indexOffset;
+    m_entries.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        Entry entry;
+        std::uint32_t nameLength;
+        if (!readPod(cursor, end, entry.type) || !readPod(cursor, end, entry.offset)
+            || !readPod(cursor, end, entry.size) || !readPod(cursor, end, entry.param0)
+            || !readPod(cursor, end, entry.param1) || !readPod(cursor, end, nameLength)
+            || static_cast<std::uint64_t>(end - cursor) < nameLength)
+            return false;
+
+        // payloads live between the header and the index
+        if (entry.offset < AssetPackFormat::HeaderSize || entry.offset > indexOffset
+            || entry.size > indexOffset - entry.offset)
+            return false;
+
+        std::string name(reinterpret_cast<const char*>(cursor), nameLength);
+        cursor += nameLength;
+        m_entries[name] = entry;
+    }
+    return true;
+}
+
+
+bool AssetPackWriter::open(const std::string& path) {
+    m_out.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_out)
+        return false;
+
+    // header is rewritten by finish() once the index offset is known
+    m_out.write(AssetPackFormat::Magic, sizeof(AssetPackFormat::Magic));
+    writePod(m_out, AssetPackFormat::Version);
+    writePod(m_out, std::uint32_t(0));
+    writePod(m_out, std::uint64_t(0));
+    m_offset = AssetPackFormat::HeaderSize;
+    m_index.clear();
+    return static_cast<bool>(m_out);
+}
+
+
+void AssetPackWriter::add(AssetPack::Type type, const std::string& name, const void* data, std::uint64_t size,
+    std::uint32_t param0, std::uint32_t param1) {
+    static const char zeros[AssetPackFormat::Alignment] = {};
+    auto padding = (AssetPackFormat::Alignment - m_offset % AssetPackFormat::Alignment) % AssetPackFormat::Alignment;
+    m_out.write(zeros, static_cast<std::streamsize>(padding));
+    m_offset += padding;
+
+    m_out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    m_index.push_back(IndexEntry{ name, AssetPack::Entry{ type, m_offset, size, param0, param1 } });
+    m_offset += size;
+}
+
+
+bool AssetPackWriter::finish() {
+    std::uint64_t indexOffset = m_offset;
+    for (const auto& [name, entry] : m_index) {
+        writePod(m_out, entry.type);
+        writePod(m_out, entry.offset);
+        writePod(m_out, entry.size);
+        writePod(m_out, entry.param0);
+        writePod(m_out, entry.param1);
+        writePod(m_out, static_cast<std::uint32_t>(name.size()));
+        m_out.write(name.data(), static_cast<std::streamsize>(name.size()));
+        m_offset += 4 + 8 + 8 + 4 + 4 + 4 + name.size();
+    }
+
+    m_out.seekp(sizeof(AssetPackFormat::Magic) + sizeof(std::uint32_t));
+    writePod(m_out, static_cast<std::uint32_t>(m_index.size()));
+    writePod(m_out, indexOffset);
+    m_out.close();
+    return !m_out.fail();
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Single file holding config.txt and every asset it names, written offline by
+// the AssetPacker tool. Layout, all little endian:
+//
+//   header   "GEXPACK\0", u32 version, u32 entry count, u64 index offset
+//   blobs    16 byte aligned payloads
+//   index    per entry: u32 type, u64 offset, u64 size, u32 param0, u32 param1,
+//            u32 name length, name bytes
+//
+// Entries are named by the path config.txt uses for them. Textures are raw
+// RGBA8 (params: width, height), sounds raw Int16 PCM (params: channel count,
+// sample rate), fonts and the config are the original file bytes.
+namespace AssetPackFormat {
+    constexpr char          Magic[8]    = { 'G', 'E', 'X', 'P', 'A', 'C', 'K', '\0' };
+    constexpr std::uint32_t Version     = 1;
+    constexpr std::uint64_t Alignment   = 16;
+    constexpr std::uint64_t HeaderSize  = 24;
+    inline const std::string ConfigName = "config.txt";
+}
+
+
+// Read side: the whole file is memory-mapped, so opening costs one mapping and
+// the index, and payload pages are only read from disk once something touches them.
+class AssetPack {
+public:
+    enum class Type : std::uint32_t {
+        Config,
+        Texture,
+        Sound,
+        Font,
+    };
+
+    struct Entry {
+        Type            type;
+        std::uint64_t   offset;
+        std::uint64_t   size;
+        std::uint32_t   param0;
+        std::uint32_t   param1;
+    };
+
+private:
+    const std::uint8_t*                     m_data{ nullptr };
+    std::uint64_t                           m_size{ 0 };
+    void*                                   m_file{ nullptr };      // Windows file and mapping handles
+    void*                                   m_mapping{ nullptr };
+    std::string                             m_path;
+    std::unordered_map<std::string, Entry>  m_entries;
+
+    bool map(const std::string& path);
+    bool readIndex();
+
+public:
+    AssetPack() = default;
+    ~AssetPack();
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    // cheap check of the magic, used to tell a pack from a text config
+    static bool isPack(const std::string& path);
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+    const std::string& getPath() const { return m_path; }
+
+    // nullptr when the pack has no entry of that type under the name
+    const Entry* find(Type type, const std::string& name) const;
+
+    // stays valid until close()
+    const std::uint8_t* data(const Entry& entry) const { return m_data + entry.offset; }
+};
+
+
+// Write side, used by the packer: blobs are streamed out as they are added and
+// the index is appended by finish().
+class AssetPackWriter {
+private:
+    struct IndexEntry {
+        std::string         name;
+        AssetPack::Entry    entry;
+    };
+
+    std::ofstream           m_out;
+    std::uint64_t           m_offset{ 0 };
+    std::vector<IndexEntry> m_index;
+
+public:
+    bool open(const std::string& path);
+    void add(AssetPack::Type type, const std::string& name, const void* data, std::uint64_t size,
+        std::uint32_t param0 = 0, std::uint32_t param1 = 0);
+    bool finish();
+
+    size_t getEntryCount() const { return m_index.size(); }
+    std::uint64_t getSize() const { return m_offset; }
+};
@@ -1,11 +1,69 @@
 #include "Assets.h"
+#include "AtlasPacker.h"
 #include "json.hpp"
 #include <fstream>
 #include <iostream>
 #include <filesystem>
 #include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <cassert>
+
+namespace {
+    const unsigned AtlasPageSize = 2048;
+    const unsigned AtlasMaxImageSize = 1024;    // anything bigger keeps its own texture
+    const unsigned AtlasPadding = 2;
+    const int AtlasCacheVersion = 1;
+    const std::string AtlasManifest = "atlas.manifest";
+    const float DefaultBudgetMB = 256.f;
+    const size_t BytesPerMB = 1024 * 1024;
+
+    template<typename Map>
+    size_t logChanges(const Map& before, const Map& after) {
+        size_t changes = 0;
+        for (const auto& [key, value] : after) {
+            auto found = before.find(key);
+            if (found == before.end() || !(found->second == value)) {
+                std::cout << "Changed value: " << key << std::endl;
+                ++changes;
+            }
+        }
+        for (const auto& [key, value] : before) {
+            if (after.find(key) == after.end()) {
+                std::cout << "Removed value: " << key << std::endl;
+                ++changes;
+            }
+        }
+        return changes;
+    }
+
+    // copies key over from the values in place before a reload
+    template<typename Map>
+    void keepValue(const Map& before, Map& after, const std::string& key) {
+        auto found = before.find(key);
+        if (found != before.end())
+            after[key] = found->second;
+    }
+
+    // size and modification time, enough to notice an edited source image
+    std::string fileStamp(const std::string& path) {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(path, ec);
+        if (ec)
+            return "missing";
+        auto time = std::filesystem::last_write_time(path, ec);
+        if (ec)
+            return "missing";
+        return std::to_string(size) + ":" + std::to_string(time.time_since_epoch().count());
+    }
+}
 
 void Assets::loadFromFile(const std::string& path) {
+    if (AssetPack::isPack(path)) {
+        loadFromPack(path);
+        return;
+    }
+
     std::ifstream config(path);
     if (config.fail()) {
         std::cerr << "Open file " << path << " failed\n";
@@ -16,6 +74,39 @@ void Assets::loadFromFile(const std::string& path) {
     std::cout << "Loading assets from: " << path << std::endl;
     std::cout << "Current working directory: " << std::filesystem::current_path() << std::endl;
 
+    if (!_loader)
+        _loader = std::make_unique<ThreadPool>();
+    _loading = true;
+
+    parseConfig(config);
+    config.close();
+
+    _atlasCacheDir = getString("AtlasCache", "atlas_cache");
+    startTextureLoading();
+}
+
+
+// Everything in the pack is already decoded, so the only work left here is
+// the config text and the atlas pages. The rest is read when first used.
+void Assets::loadFromPack(const std::string& path) {
+    if (!_pack.open(path))
+        exit(1);
+
+    const auto* config = _pack.find(AssetPack::Type::Config, AssetPackFormat::ConfigName);
+    if (!config) {
+        std::cerr << "Asset pack " << path << " has no " << AssetPackFormat::ConfigName << "\n";
+        exit(1);
+    }
+
+    std::cout << "Loading assets from pack: " << path << std::endl;
+
+    std::istringstream text(std::string(reinterpret_cast<const char*>(_pack.data(*config)), config->size));
+    parseConfig(text);
+    loadPackedTextures();
+}
+
+
+void Assets::parseConfig(std::istream& config) {
     std::string line;
     while (std::getline(config, line)) {
         if (line.empty() || line[0] == '#')
@@ -47,157 +138,873 @@ void Assets::loadFromFile(const std::string& path) {
         else if (token == "Font") {
             std::string name, fontPath;
             iss >> name >> fontPath;
-            sf::Font font;
-            if (!font.loadFromFile(fontPath)) {
-                std::cerr << "Failed to load font " << fontPath << "\n";
-            }
-            else {
-                _fonts[name] = font;
-                logAssetLoaded("font", name, fontPath);
-            }
+            loadFont(name, fontPath);
         }
         else if (token == "Texture") {
-            std::string name, texturePath;
-            iss >> name >> texturePath;
-            sf::Texture texture;
-            if (!texture.loadFromFile(texturePath)) {
-                std::cerr << "Failed to load texture " << texturePath << "\n";
-            }
-            else {
-                _textures[name] = texture;
-                logAssetLoaded("texture", name, texturePath);
-            }
+            // textures are loaded together once the whole file is read so they can be packed
+            std::string name, texturePath, option;
+            iss >> name >> texturePath >> option;
+            auto id = _textureRegions.add(name);
+            _textureSources.resize(_textureRegions.size());
+            _textureSources[id.index] = TextureSource{ id, name, texturePath, option == "smooth" };
         }
         else if (token == "Sound") {
             std::string name, soundPath;
             iss >> name >> soundPath;
-            sf::SoundBuffer soundBuffer;
-            if (!soundBuffer.loadFromFile(soundPath)) {
-                std::cerr << "Failed to load sound " << soundPath << "\n";
-            }
-            else {
-                _soundBuffers[name] = soundBuffer;
-                logAssetLoaded("sound", name, soundPath);
-            }
+            auto id = _soundBuffers.add(name);
+            _soundPaths.resize(_soundBuffers.size());
+            _soundPaths[id.index] = soundPath;
+            if (!_pack.isOpen() && !_headless)
+                queueSound(id);
         }
         else {
-            float x, y;
-            iss >> x;
-            if (!iss.fail()) {
-                iss >> y;
-                if (!iss.fail()) {
-                    _vectorValues[token] = sf::Vector2f(x, y);
-                    continue;
-                }
-            }
+            parseValue(iss, token);
+        }
+    }
 
-            iss.clear();
-            iss.seekg(0);
-            iss >> token;
+    // the tables are complete, standalone textures get their slots
+    if (!_headless)
+        _textures.resize(_textureRegions.size());
+    _textureResidency.resize(_textureRegions.size());
+    _soundResidency.resize(_soundBuffers.size());
+    readBudget();
+}
+
+
+void Assets::readBudget() {
+    _budgetBytes = static_cast<size_t>(std::max(0.f, getFloat("AssetBudgetMB", DefaultBudgetMB)) * BytesPerMB);
+}
+
+
+// numbers, vectors and strings from one config line, token already read
+void Assets::parseValue(std::istringstream& iss, std::string token) {
+    float x, y;
+    iss >> x;
+    if (!iss.fail()) {
+        iss >> y;
+        if (!iss.fail()) {
+            _vectorValues[token] = sf::Vector2f(x, y);
+            return;
+        }
+    }
+
+    iss.clear();
+    iss.seekg(0);
+    iss >> token;
+
+    float floatValue;
+    iss >> floatValue;
+    if (!iss.fail()) {
+        _floatValues[token] = floatValue;
+        return;
+    }
+
+    iss.clear();
+    iss.seekg(0);
+    iss >> token;
+
+    int intValue;
+    iss >> intValue;
+    if (!iss.fail()) {
+        _intValues[token] = intValue;
+        return;
+    }
+
+    iss.clear();
+    iss.seekg(0);
+    iss >> token;
+
+    std::string stringValue;
+    std::getline(iss >> std::ws, stringValue);
+    if (!stringValue.empty()) {
+        if (stringValue.front() == '"' && stringValue.back() == '"') {
+            stringValue = stringValue.substr(1, stringValue.size() - 2);
+        }
+        _stringValues[token] = stringValue;
+    }
+}
+
+
+// Re-reads the value lines of the config, leaving fonts, textures and sounds
+// alone. The values are rebuilt from the file, so a deleted line falls back to
+// its default; the ones that need a restart keep what they started with.
+// Bumps the revision when anything changed.
+bool Assets::reloadValues(const std::string& path) {
+    if (_pack.isOpen()) {
+        std::cerr << "Values are baked into " << _pack.getPath() << ", restart to pick up a rebuilt pack\n";
+        return false;
+    }
+
+    std::ifstream config(path);
+    if (config.fail()) {
+        std::cerr << "Open file " << path << " failed\n";
+        return false;
+    }
+
+    auto floatValues = std::move(_floatValues);
+    auto intValues = std::move(_intValues);
+    auto stringValues = std::move(_stringValues);
+    auto vectorValues = std::move(_vectorValues);
+    _floatValues.clear();
+    _intValues.clear();
+    _stringValues.clear();
+    _vectorValues.clear();
+    keepValue(vectorValues, _vectorValues, "WindowSize");
+    keepValue(stringValues, _stringValues, "WindowTitle");
+    keepValue(intValues, _intValues, "FrameRate");
+
+    std::string line;
+    while (std::getline(config, line)) {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream iss(line);
+        std::string token;
+        iss >> token;
+
+        // these need a restart
+        if (token == "Window" || token == "WindowTitle" || token == "FrameRate"
+            || token == "Font" || token == "Texture" || token == "Sound")
+            continue;
+
+        parseValue(iss, token);
+    }
+
+    size_t changes = logChanges(floatValues, _floatValues)
+        + logChanges(intValues, _intValues)
+        + logChanges(stringValues, _stringValues)
+        + logChanges(vectorValues, _vectorValues);
+    if (changes == 0)
+        return false;
+
+    ++_revision;
+    readBudget();
+    std::cout << "Reloaded " << changes << " values from " << path << std::endl;
+    return true;
+}
+
+
+// fonts read their file lazily, so a packed font is used in place
+void Assets::loadFont(const std::string& name, const std::string& path) {
+    sf::Font font;
+    bool loaded = false;
+    if (_pack.isOpen()) {
+        const auto* entry = _pack.find(AssetPack::Type::Font, path);
+        loaded = entry && font.loadFromMemory(_pack.data(*entry), static_cast<size_t>(entry->size));
+    }
+    else {
+        loaded = font.loadFromFile(path);
+    }
+
+    if (!loaded) {
+        std::cerr << "Failed to load font " << path << "\n";
+        return;
+    }
+    _fonts[_fonts.add(name)] = font;
+    logAssetLoaded("font", name, path);
+}
+
+
+void Assets::queueImage(const std::string& path) {
+    auto image = _loader->submit([path]() {
+        sf::Image image;
+        image.loadFromFile(path);
+        return image;
+        });
+    _pendingImages.push_back(PendingImage{ path, std::move(image) });
+    ++_loadSteps;
+}
+
+
+// only the sample decoding runs on the worker, the OpenAL buffer is made in update()
+void Assets::queueSound(SoundId id) {
+    auto sound = _loader->submit([path = _soundPaths[id.index]]() {
+        DecodedSound decoded;
+        sf::InputSoundFile file;
+        if (!file.openFromFile(path))
+            return decoded;
+
+        decoded.samples.resize(static_cast<size_t>(file.getSampleCount()));
+        auto read = file.read(decoded.samples.data(), decoded.samples.size());
+        decoded.samples.resize(static_cast<size_t>(read));
+        decoded.channelCount = file.getChannelCount();
+        decoded.sampleRate = file.getSampleRate();
+        return decoded;
+        });
+    _pendingSounds.push_back(PendingSound{ id, std::move(sound) });
+    ++_loadSteps;
+}
+
+
+// a valid cache needs only its pages and the standalone images decoded
+void Assets::startTextureLoading() {
+    _texturesReady = false;
+
+    AtlasLayout layout;
+    if (readAtlasManifest(layout)) {
+        for (const auto& page : layout.pages)
+            queueImage(_atlasCacheDir + "/" + page.file);
+        for (const auto& source : _textureSources) {
+            if (layout.entries[source.name].page < 0)
+                queueImage(source.path);
+        }
+        _cachedAtlas = std::move(layout);
+        return;
+    }
+
+    _cachedAtlas.reset();
+    for (const auto& source : _textureSources)
+        queueImage(source.path);
+}
+
+
+void Assets::update() {
+    if (_loading)
+        pollLoading();
+
+    if (_textureStats.residentBytes + _soundStats.residentBytes > _budgetBytes)
+        enforceBudget();
+}
+
+
+void Assets::pollLoading() {
+    auto ready = [](const auto& future) {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    };
+
+    for (auto it = _pendingSounds.begin(); it != _pendingSounds.end();) {
+        if (!ready(it->sound)) {
+            ++it;
+            continue;
+        }
+
+        DecodedSound decoded = it->sound.get();
+        auto& buffer = _soundBuffers[it->id];
+        const std::string& path = _soundPaths[it->id.index];
+        if (_soundResidency[it->id.index].bytes > 0) {
+            // already loaded on demand while this one was decoding
+        }
+        else if (decoded.samples.empty()
+            || !(buffer = std::make_unique<sf::SoundBuffer>())->loadFromSamples(decoded.samples.data(), decoded.samples.size(), decoded.channelCount, decoded.sampleRate)) {
+            std::cerr << "Failed to load sound " << path << "\n";
+        }
+        else {
+            markResident(_soundResidency[it->id.index], _soundStats, decoded.samples.size() * sizeof(sf::Int16));
+            logAssetLoaded("sound", _soundBuffers.getName(it->id), path);
+        }
+
+        ++_loadStepsDone;
+        it = _pendingSounds.erase(it);
+    }
+
+    for (auto it = _pendingImages.begin(); it != _pendingImages.end();) {
+        if (!ready(it->image)) {
+            ++it;
+            continue;
+        }
+
+        _decodedImages[it->path] = it->image.get();
+        ++_loadStepsDone;
+        it = _pendingImages.erase(it);
+    }
+
+    // packing needs every image, uploading has to happen on this thread
+    if (!_texturesReady && _pendingImages.empty())
+        finishTextures();
+
+    if (_texturesReady && _pendingSounds.empty()) {
+        _decodedImages.clear();
+        _loading = false;
+        std::cout << "All assets loaded" << std::endl;
+    }
+}
+
+
+float Assets::getLoadProgress() const {
+    if (!_loading)
+        return 1.0f;
+    // the last step is building the textures
+    return static_cast<float>(_loadStepsDone) / static_cast<float>(_loadSteps + 1);
+}
+
+
+void Assets::finishTextures() {
+    if (_cachedAtlas) {
+        if (restoreCachedAtlas()) {
+            std::cout << "Loaded texture atlas from cache " << _atlasCacheDir << std::endl;
+            _texturesReady = true;
+            return;
+        }
+
+        std::cerr << "Texture atlas cache in " << _atlasCacheDir << " is unusable, repacking\n";
+        _cachedAtlas.reset();
+        for (const auto& source : _textureSources) {
+            if (!_decodedImages.contains(source.path))
+                queueImage(source.path);
+        }
+        if (!_pendingImages.empty())
+            return;
+    }
+
+    buildAtlas(_textureSources);
+    _texturesReady = true;
+}
 
-            float floatValue;
-            iss >> floatValue;
-            if (!iss.fail()) {
-                _floatValues[token] = floatValue;
-                continue;
-            }
 
-            iss.clear();
-            iss.seekg(0);
-            iss >> token;
+void Assets::addStandaloneTexture(const TextureSource& source, const sf::Image& image) {
+    Residency& residency = _textureResidency[source.id.index];
+    if (residency.bytes > 0)
+        return;
 
-            int intValue;
-            iss >> intValue;
-            if (!iss.fail()) {
-                _intValues[token] = intValue;
+    sf::Texture* texture = _headless ? nullptr : &_textures[source.id.index];
+    if (texture) {
+        if (!texture->loadFromImage(image)) {
+            std::cerr << "Failed to load texture " << source.path << "\n";
+            return;
+        }
+        texture->setSmooth(source.smooth);
+    }
+
+    auto size = image.getSize();
+    _textureRegions[source.id] = TextureRegion{ texture, sf::IntRect(0, 0, size.x, size.y) };
+    markResident(residency, _textureStats, static_cast<size_t>(size.x) * size.y * 4);
+    logAssetLoaded("texture", source.name, source.path);
+}
+
+
+// The cache is only used when it lists exactly the configured textures and
+// none of their files changed since it was written, otherwise we repack.
+bool Assets::readAtlasManifest(AtlasLayout& layout) const {
+    std::ifstream manifest(_atlasCacheDir + "/" + AtlasManifest);
+    if (manifest.fail())
+        return false;
+
+    std::string token;
+    int version = 0;
+    manifest >> token >> version;
+    if (token != "AtlasVersion" || version != AtlasCacheVersion)
+        return false;
+
+    while (manifest >> token) {
+        if (token == "Page") {
+            size_t index;
+            int smooth;
+            AtlasLayout::Page page;
+            manifest >> index >> page.file >> smooth;
+            if (manifest.fail() || index != layout.pages.size())
+                return false;
+            page.smooth = smooth != 0;
+            layout.pages.push_back(page);
+        }
+        else if (token == "Texture") {
+            std::string name;
+            int smooth;
+            AtlasLayout::Entry entry;
+            manifest >> name >> entry.path >> entry.stamp >> smooth >> entry.page
+                >> entry.rect.left >> entry.rect.top >> entry.rect.width >> entry.rect.height;
+            if (manifest.fail() || entry.page >= static_cast<int>(layout.pages.size()))
+                return false;
+            entry.smooth = smooth != 0;
+            layout.entries[name] = entry;
+        }
+        else {
+            return false;
+        }
+    }
+
+    if (layout.entries.size() != _textureSources.size())
+        return false;
+    for (const auto& source : _textureSources) {
+        auto found = layout.entries.find(source.name);
+        if (found == layout.entries.end()
+            || found->second.path != source.path
+            || found->second.smooth != source.smooth
+            || found->second.stamp != fileStamp(source.path))
+            return false;
+    }
+    return true;
+}
+
+
+// nothing is touched unless every cached page decoded
+bool Assets::restoreCachedAtlas() {
+    const auto& layout = *_cachedAtlas;
+    for (const auto& page : layout.pages) {
+        auto found = _decodedImages.find(_atlasCacheDir + "/" + page.file);
+        if (found == _decodedImages.end() || found->second.getSize().x == 0)
+            return false;
+    }
+
+    if (!_headless)
+        _atlasPages.resize(layout.pages.size());
+    for (size_t i = 0; i < layout.pages.size(); ++i) {
+        const sf::Image& image = _decodedImages[_atlasCacheDir + "/" + layout.pages[i].file];
+        if (!_headless) {
+            if (!_atlasPages[i].loadFromImage(image))
+                std::cerr << "Failed to create atlas page " << i << "\n";
+            _atlasPages[i].setSmooth(layout.pages[i].smooth);
+        }
+        addPinnedBytes(image.getSize());
+    }
+
+    for (const auto& source : _textureSources) {
+        const auto& entry = layout.entries.at(source.name);
+        if (entry.page >= 0) {
+            _textureRegions[source.id] = TextureRegion{ atlasPage(entry.page), entry.rect };
+            _textureResidency[source.id.index].pinned = true;
+            continue;
+        }
+
+        const sf::Image& image = _decodedImages[source.path];
+        if (image.getSize().x == 0)
+            std::cerr << "Failed to load texture " << source.path << "\n";
+        else
+            addStandaloneTexture(source, image);
+    }
+    return true;
+}
+
+
+void Assets::buildAtlas(const std::vector<TextureSource>& sources) {
+    struct PackedImage {
+        const TextureSource*    source;
+        const sf::Image*        image;
+        int                     page;
+        sf::Vector2u            position;
+    };
+    std::vector<PackedImage> packed;
+
+    for (const auto& source : sources) {
+        const sf::Image& image = _decodedImages[source.path];
+        auto size = image.getSize();
+        if (size.x == 0) {
+            std::cerr << "Failed to load texture " << source.path << "\n";
+            continue;
+        }
+
+        if (size.x > AtlasMaxImageSize || size.y > AtlasMaxImageSize)
+            addStandaloneTexture(source, image);
+        else
+            packed.push_back(PackedImage{ &source, &image, -1, sf::Vector2u(0, 0) });
+    }
+
+    // tallest first keeps the skyline flat, names break ties so the layout is stable
+    std::sort(packed.begin(), packed.end(), [](const PackedImage& a, const PackedImage& b) {
+        if (a.image->getSize().y != b.image->getSize().y)
+            return a.image->getSize().y > b.image->getSize().y;
+        return a.source->name < b.source->name;
+        });
+
+    // smooth and pixel-exact textures can't share a page, filtering is per texture.
+    // Asking for the maximum size needs a GL context, which headless may not have.
+    unsigned pageSize = _headless ? AtlasPageSize : std::min(AtlasPageSize, sf::Texture::getMaximumSize());
+    std::vector<AtlasPacker> packers;
+    std::vector<bool> pageSmooth;
+
+    for (auto& entry : packed) {
+        for (size_t i = 0; i < packers.size() && entry.page < 0; ++i) {
+            if (pageSmooth[i] == entry.source->smooth && packers[i].insert(entry.image->getSize(), entry.position))
+                entry.page = static_cast<int>(i);
+        }
+
+        if (entry.page < 0) {
+            AtlasPacker packer(sf::Vector2u(pageSize, pageSize), AtlasPadding);
+            if (!packer.insert(entry.image->getSize(), entry.position)) {
+                addStandaloneTexture(*entry.source, *entry.image);
                 continue;
             }
+            packers.push_back(packer);
+            pageSmooth.push_back(entry.source->smooth);
+            entry.page = static_cast<int>(packers.size() - 1);
+        }
+    }
+
+    std::vector<sf::Image> pageImages(packers.size());
+    for (size_t i = 0; i < packers.size(); ++i) {
+        auto used = packers[i].getUsedSize();
+        pageImages[i].create(used.x, used.y, sf::Color::Transparent);
+    }
+
+    for (const auto& entry : packed) {
+        if (entry.page >= 0)
+            pageImages[entry.page].copy(*entry.image, entry.position.x, entry.position.y);
+    }
 
-            iss.clear();
-            iss.seekg(0);
-            iss >> token;
-
-            std::string stringValue;
-            std::getline(iss >> std::ws, stringValue);
-            if (!stringValue.empty()) {
-                if (stringValue.front() == '"' && stringValue.back() == '"') {
-                    stringValue = stringValue.substr(1, stringValue.size() - 2);
-                }
-                _stringValues[token] = stringValue;
+    if (!_headless)
+        _atlasPages.resize(packers.size());
+    for (size_t i = 0; i < packers.size(); ++i) {
+        if (!_headless) {
+            if (!_atlasPages[i].loadFromImage(pageImages[i]))
+                std::cerr << "Failed to create atlas page " << i << "\n";
+            _atlasPages[i].setSmooth(pageSmooth[i]);
+        }
+        addPinnedBytes(pageImages[i].getSize());
+    }
+
+    for (const auto& entry : packed) {
+        if (entry.page < 0)
+            continue;
+
+        auto size = entry.image->getSize();
+        _textureRegions[entry.source->id] = TextureRegion{ atlasPage(entry.page),
+            sf::IntRect(entry.position.x, entry.position.y, size.x, size.y) };
+        _textureResidency[entry.source->id.index].pinned = true;
+        logAssetLoaded("texture", entry.source->name, entry.source->path);
+    }
+
+    std::cout << "Packed " << packed.size() << " textures into " << packers.size() << " atlas pages" << std::endl;
+
+    // nothing to cache when the sources came out of a pack
+    if (_pack.isOpen())
+        return;
+
+    std::ostringstream manifest;
+    manifest << "AtlasVersion " << AtlasCacheVersion << "\n";
+    for (size_t i = 0; i < pageImages.size(); ++i)
+        manifest << "Page " << i << " atlas_" << i << ".png " << pageSmooth[i] << "\n";
+
+    // headless regions have no texture to tell pages apart by, so go by the packing
+    std::vector<int> pageOf(_textureRegions.size(), -1);
+    for (const auto& entry : packed)
+        pageOf[entry.source->id.index] = entry.page;
+
+    for (const auto& source : sources) {
+        if (!isResident(source.id))
+            continue;
+
+        const auto& region = _textureRegions[source.id];
+        int page = pageOf[source.id.index];
+        manifest << "Texture " << source.name << " " << source.path << " " << fileStamp(source.path)
+            << " " << source.smooth << " " << page << " " << region.rect.left << " " << region.rect.top
+            << " " << region.rect.width << " " << region.rect.height << "\n";
+    }
+
+    // PNG encoding is slow, write the cache in the background; the manifest
+    // goes last so a half written cache is never picked up
+    _loader->submit([cacheDir = _atlasCacheDir, pageImages = std::move(pageImages), text = manifest.str()]() {
+        std::error_code ec;
+        std::filesystem::create_directories(cacheDir, ec);
+        for (size_t i = 0; i < pageImages.size(); ++i) {
+            if (ec || !pageImages[i].saveToFile(cacheDir + "/atlas_" + std::to_string(i) + ".png")) {
+                std::cerr << "Failed to write texture atlas cache to " << cacheDir << "\n";
+                return;
             }
         }
+        std::ofstream(cacheDir + "/" + AtlasManifest) << text;
+        });
+}
+
+
+// Copying the pixels out of the mapping is all the work a packed texture
+// needs. Only atlas candidates are touched here, large ones wait for getTexture.
+void Assets::loadPackedTextures() {
+    std::vector<TextureSource> atlasSources;
+    for (const auto& source : _textureSources) {
+        const auto* entry = _pack.find(AssetPack::Type::Texture, source.path);
+        if (!entry) {
+            std::cerr << "Texture " << source.path << " missing from " << _pack.getPath() << "\n";
+            continue;
+        }
+        if (entry->param0 > AtlasMaxImageSize || entry->param1 > AtlasMaxImageSize)
+            continue;
+
+        _decodedImages[source.path].create(entry->param0, entry->param1, _pack.data(*entry));
+        atlasSources.push_back(source);
     }
 
-    config.close();
+    buildAtlas(atlasSources);
+    _decodedImages.clear();
 }
 
 
+// Brings back a standalone texture that was evicted or never loaded. From a
+// pack that is one copy out of the mapping, otherwise the file is decoded here.
+const TextureRegion* Assets::loadTexture(TextureId id) {
+    Residency& residency = _textureResidency[id.index];
+    if (residency.pinned)
+        return nullptr;
 
-const sf::Texture& Assets::getTexture(const std::string& name) const {
-    if (!_textures.contains(name)) {
-        std::cerr << "Texture " << name << " not found!\n";
-        static sf::Texture defaultTexture;
-        return defaultTexture;
+    const TextureSource& source = _textureSources[id.index];
+    sf::Texture* texture = _headless ? nullptr : &_textures[id.index];
+    sf::Vector2u size;
+    bool loaded = false;
+    if (_pack.isOpen()) {
+        const auto* entry = _pack.find(AssetPack::Type::Texture, source.path);
+        if (entry) {
+            size = sf::Vector2u(entry->param0, entry->param1);
+            loaded = !texture || texture->create(size.x, size.y);
+            if (loaded && texture)
+                texture->update(_pack.data(*entry));
+        }
+    }
+    else if (!texture) {
+        // only the size is needed without a GPU
+        sf::Image image;
+        loaded = image.loadFromFile(source.path);
+        size = image.getSize();
     }
-    return _textures.at(name);
+    else {
+        loaded = texture->loadFromFile(source.path);
+        size = texture->getSize();
+    }
+
+    if (!loaded) {
+        std::cerr << "Failed to load texture " << source.path << "\n";
+        return nullptr;
+    }
+    if (texture)
+        texture->setSmooth(source.smooth);
+    logAssetLoaded("texture", source.name, _pack.isOpen() ? _pack.getPath() : source.path);
+
+    auto& region = _textureRegions[id];
+    region = TextureRegion{ texture, sf::IntRect(0, 0, size.x, size.y) };
+    markResident(residency, _textureStats, static_cast<size_t>(size.x) * size.y * 4);
+    return &region;
 }
 
-const sf::Font& Assets::getFont(const std::string& name) const {
-    if (!_fonts.contains(name)) {
-        std::cerr << "Font " << name << " not found!\n";
-        static sf::Font defaultFont;
 
-#ifdef _WIN32
-        if (defaultFont.loadFromFile("C:/Windows/Fonts/arial.ttf")) {
-            return defaultFont;
+const sf::SoundBuffer* Assets::loadSound(SoundId id) {
+    if (_headless)
+        return nullptr;
+
+    const std::string& path = _soundPaths[id.index];
+    auto& slot = _soundBuffers[id];
+    if (!slot)
+        slot = std::make_unique<sf::SoundBuffer>();
+    sf::SoundBuffer& buffer = *slot;
+    bool loaded = false;
+    if (_pack.isOpen()) {
+        // blobs are 16 byte aligned, so the samples are read straight out of the mapping
+        const auto* entry = _pack.find(AssetPack::Type::Sound, path);
+        loaded = entry && buffer.loadFromSamples(reinterpret_cast<const sf::Int16*>(_pack.data(*entry)),
+            entry->size / sizeof(sf::Int16), entry->param0, entry->param1);
+    }
+    else {
+        loaded = buffer.loadFromFile(path);
+    }
+
+    if (!loaded) {
+        std::cerr << "Failed to load sound " << path << "\n";
+        return nullptr;
+    }
+    logAssetLoaded("sound", _soundBuffers.getName(id), _pack.isOpen() ? _pack.getPath() : path);
+    markResident(_soundResidency[id.index], _soundStats, static_cast<size_t>(buffer.getSampleCount()) * sizeof(sf::Int16));
+    return &buffer;
+}
+
+
+void Assets::markResident(Residency& residency, ResidencyStats& stats, size_t bytes) {
+    residency.bytes = bytes;
+    touch(residency);
+    stats.residentBytes += bytes;
+    stats.peakBytes = std::max(stats.peakBytes, stats.residentBytes);
+    ++stats.residentCount;
+    ++stats.loads;
+}
+
+
+void Assets::markEvicted(Residency& residency, ResidencyStats& stats) {
+    stats.residentBytes -= residency.bytes;
+    --stats.residentCount;
+    ++stats.evictions;
+    residency.bytes = 0;
+}
+
+
+// atlas pages hold every small texture and are never evicted
+void Assets::addPinnedBytes(sf::Vector2u pageSize) {
+    _textureStats.residentBytes += static_cast<size_t>(pageSize.x) * pageSize.y * 4;
+    ++_textureStats.residentCount;
+    _textureStats.peakBytes = std::max(_textureStats.peakBytes, _textureStats.residentBytes);
+}
+
+
+// Linear scans are fine at this asset count and only run while over budget.
+// Stops early when everything left is referenced or pinned.
+void Assets::enforceBudget() {
+    auto evictable = [](const Residency& r) { return r.bytes > 0 && r.refs == 0 && !r.pinned; };
+
+    while (_textureStats.residentBytes + _soundStats.residentBytes > _budgetBytes) {
+        const Residency* oldest = nullptr;
+        for (const auto& r : _textureResidency) {
+            if (evictable(r) && (!oldest || r.lastUse < oldest->lastUse))
+                oldest = &r;
         }
-#endif
+        for (const auto& r : _soundResidency) {
+            if (evictable(r) && (!oldest || r.lastUse < oldest->lastUse))
+                oldest = &r;
+        }
+        if (!oldest)
+            return;
+
+        if (oldest >= _textureResidency.data() && oldest < _textureResidency.data() + _textureResidency.size()) {
+            TextureId id{ static_cast<std::uint32_t>(oldest - _textureResidency.data()) };
+            std::cout << "Evicted texture " << _textureRegions.getName(id) << " (" << oldest->bytes / 1024 << " KB)" << std::endl;
+            if (!_headless)
+                _textures[id.index] = sf::Texture();
+            _textureRegions[id] = TextureRegion{};
+            markEvicted(_textureResidency[id.index], _textureStats);
+        }
+        else {
+            SoundId id{ static_cast<std::uint32_t>(oldest - _soundResidency.data()) };
+            std::cout << "Evicted sound " << _soundBuffers.getName(id) << " (" << oldest->bytes / 1024 << " KB)" << std::endl;
+            _soundBuffers[id].reset();
+            markEvicted(_soundResidency[id.index], _soundStats);
+        }
+    }
+}
 
-        static sf::Font emptyFont;
-        return emptyFont;
+
+void Assets::acquire(TextureId id) {
+    if (_textureRegions.contains(id))
+        ++_textureResidency[id.index].refs;
+}
+
+void Assets::release(TextureId id) {
+    if (_textureRegions.contains(id)) {
+        auto& residency = _textureResidency[id.index];
+        // an unmatched release would wrap the count and pin the asset for good
+        assert(residency.refs > 0);
+        if (residency.refs > 0)
+            --residency.refs;
+        touch(residency);
     }
-    return _fonts.at(name);
 }
 
-const sf::SoundBuffer& Assets::getSoundBuffer(const std::string& name) const {
-    if (!_soundBuffers.contains(name)) {
+void Assets::acquire(SoundId id) {
+    if (_soundBuffers.contains(id))
+        ++_soundResidency[id.index].refs;
+}
+
+void Assets::release(SoundId id) {
+    if (_soundBuffers.contains(id)) {
+        auto& residency = _soundResidency[id.index];
+        // an unmatched release would wrap the count and pin the asset for good
+        assert(residency.refs > 0);
+        if (residency.refs > 0)
+            --residency.refs;
+        touch(residency);
+    }
+}
+
+
+TextureId Assets::textureId(const std::string& name) const {
+    auto id = _textureRegions.find(name);
+    if (!id.isValid())
+        std::cerr << "Texture " << name << " not found!\n";
+    return id;
+}
+
+FontId Assets::fontId(const std::string& name) const {
+    auto id = _fonts.find(name);
+    if (!id.isValid())
+        std::cerr << "Font " << name << " not found!\n";
+    return id;
+}
+
+SoundId Assets::soundId(const std::string& name) const {
+    auto id = _soundBuffers.find(name);
+    if (!id.isValid())
         std::cerr << "Sound " << name << " not found!\n";
-        static sf::SoundBuffer defaultBuffer;
-        return defaultBuffer;
+    return id;
+}
+
+
+bool Assets::isResident(TextureId id) const {
+    const Residency& residency = _textureResidency[id.index];
+    return residency.pinned || residency.bytes > 0;
+}
+
+
+// invalid ids were already reported when they were resolved
+const TextureRegion& Assets::getTexture(TextureId id) {
+    if (_textureRegions.contains(id)) {
+        touch(_textureResidency[id.index]);
+        if (isResident(id))
+            return _textureRegions[id];
+        if (const TextureRegion* loaded = loadTexture(id))
+            return *loaded;
     }
-    return _soundBuffers.at(name);
+
+    // headless the empty region has no texture either, see setHeadless
+    static const TextureRegion emptyRegion;
+    if (_headless)
+        return emptyRegion;
+
+    static sf::Texture defaultTexture;
+    static const TextureRegion defaultRegion{ &defaultTexture, sf::IntRect() };
+    return defaultRegion;
+}
+
+const sf::Font& Assets::getFont(FontId id) const {
+    if (_fonts.contains(id))
+        return _fonts[id];
+
+    static sf::Font defaultFont;
+#ifdef _WIN32
+    static bool defaultLoaded = defaultFont.loadFromFile("C:/Windows/Fonts/arial.ttf");
+    if (defaultLoaded) {
+        return defaultFont;
+    }
+#endif
+
+    static sf::Font emptyFont;
+    return emptyFont;
+}
+
+const sf::SoundBuffer& Assets::getSoundBuffer(SoundId id) {
+    if (_soundBuffers.contains(id)) {
+        touch(_soundResidency[id.index]);
+        if (_soundResidency[id.index].bytes > 0)
+            return *_soundBuffers[id];
+        if (const sf::SoundBuffer* loaded = loadSound(id))
+            return *loaded;
+    }
+
+    assert(!_headless);
+    static sf::SoundBuffer defaultBuffer;
+    return defaultBuffer;
 }
 
 float Assets::getFloat(const std::string& name, float defaultValue) const {
-    if (!_floatValues.contains(name)) {
+    auto found = _floatValues.find(name);
+    if (found == _floatValues.end()) {
         std::cerr << "Float value " << name << " not found, using default: " << defaultValue << "\n";
         return defaultValue;
     }
-    return _floatValues.at(name);
+    return found->second;
 }
 
 int Assets::getInt(const std::string& name, int defaultValue) const {
-    if (!_intValues.contains(name)) {
+    auto found = _intValues.find(name);
+    if (found == _intValues.end()) {
+        // whole numbers in config.txt are parsed as floats first
+        auto whole = _floatValues.find(name);
+        if (whole != _floatValues.end()) {
+            return static_cast<int>(whole->second);
+        }
         return defaultValue;
     }
-    return _intValues.at(name);
+    return found->second;
 }
 
 const std::string& Assets::getString(const std::string& name, const std::string& defaultValue) const {
-    if (!_stringValues.contains(name)) {
+    auto found = _stringValues.find(name);
+    if (found == _stringValues.end()) {
         std::cerr << "String value " << name << " not found, using default: " << defaultValue << "\n";
         static std::string emptyString;
         emptyString = defaultValue;
         return emptyString;
     }
-    return _stringValues.at(name);
+    return found->second;
 }
 
 sf::Vector2f Assets::getVector(const std::string& name, const sf::Vector2f& defaultValue) const {
-    if (!_vectorValues.contains(name)) {
+    auto found = _vectorValues.find(name);
+    if (found == _vectorValues.end()) {
         std::cerr << "Vector value " << name << " not found, using default: ("
             << defaultValue.x << ", " << defaultValue.y << ")\n";
         return defaultValue;
     }
-    return _vectorValues.at(name);
+    return found->second;
 }
@@ -2,23 +2,154 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include <map>
+#include <unordered_map>
 #include <string>
 #include <memory>
 #include <iostream>
+#include <sstream>
+#include <vector>
+#include <future>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "AssetId.h"
+#include "AssetPack.h"
+#include "TextureRegion.h"
+#include "ThreadPool.h"
 
 
 class Assets {
+public:
+    // decoded bytes (RGBA pixels or Int16 samples) held for one asset type
+    struct ResidencyStats {
+        size_t residentBytes{ 0 };
+        size_t peakBytes{ 0 };
+        size_t residentCount{ 0 };
+        size_t loads{ 0 };
+        size_t evictions{ 0 };
+    };
+
 private:
-    std::map<std::string, sf::Texture> _textures;
-    std::map<std::string, sf::Font> _fonts;
-    std::map<std::string, sf::SoundBuffer> _soundBuffers;
-    std::map<std::string, float> _floatValues;
-    std::map<std::string, int> _intValues;
-    std::map<std::string, std::string> _stringValues;
-    std::map<std::string, sf::Vector2f> _vectorValues;
+    struct TextureSource {
+        TextureId id;
+        std::string name;
+        std::string path;
+        bool smooth;
+    };
+
+    // decoded on a worker, turned into an sf::SoundBuffer on the main thread
+    struct DecodedSound {
+        std::vector<sf::Int16> samples;
+        unsigned int channelCount{ 0 };
+        unsigned int sampleRate{ 0 };
+    };
+
+    struct PendingSound {
+        SoundId id;
+        std::future<DecodedSound> sound;
+    };
+
+    struct PendingImage {
+        std::string path;
+        std::future<sf::Image> image;   // 0x0 when decoding failed
+    };
+
+    // Textures in an atlas share their page and are pinned; standalone
+    // textures and sounds can be evicted once nothing references them.
+    struct Residency {
+        std::uint32_t refs{ 0 };
+        std::uint64_t lastUse{ 0 };
+        size_t bytes{ 0 };          // 0 while not resident
+        bool pinned{ false };
+    };
+
+    // what the atlas cache manifest says was packed where
+    struct AtlasLayout {
+        struct Page {
+            std::string file;
+            bool smooth;
+        };
+        struct Entry {
+            std::string path;
+            std::string stamp;
+            bool smooth;
+            int page;               // -1 for standalone textures
+            sf::IntRect rect;
+        };
+        std::vector<Page> pages;
+        std::map<std::string, Entry> entries;
+    };
+
+    // Small textures are packed into _atlasPages, large ones own a slot in
+    // _textures, indexed by TextureId like _textureSources. Large textures and
+    // sounds are (re)loaded on first use when they aren't resident. Headless,
+    // both texture vectors stay empty and no buffer is made: every sf::Texture
+    // and sf::SoundBuffer opens a GL context or the audio device when built.
+    AssetTable<TextureId, TextureRegion> _textureRegions;
+    std::vector<sf::Texture> _textures;
+    std::vector<sf::Texture> _atlasPages;
+    AssetTable<FontId, sf::Font> _fonts;
+    AssetTable<SoundId, std::unique_ptr<sf::SoundBuffer>> _soundBuffers;   // null while not resident
+    std::vector<std::string> _soundPaths;               // by SoundId
+    std::unordered_map<std::string, float> _floatValues;
+    std::unordered_map<std::string, int> _intValues;
+    std::unordered_map<std::string, std::string> _stringValues;
+    std::unordered_map<std::string, sf::Vector2f> _vectorValues;
+    unsigned int _revision{ 0 };
+
+    // residency, by id; see update() for eviction
+    std::vector<Residency> _textureResidency;
+    std::vector<Residency> _soundResidency;
+    ResidencyStats _textureStats;
+    ResidencyStats _soundStats;
+    std::uint64_t _useClock{ 0 };
+    size_t _budgetBytes{ 0 };
+
+    // background loading, see update()
+    std::unique_ptr<ThreadPool> _loader;
+    std::vector<TextureSource> _textureSources;         // by TextureId
+    std::string _atlasCacheDir;
+    std::optional<AtlasLayout> _cachedAtlas;
+    std::vector<PendingImage> _pendingImages;
+    std::vector<PendingSound> _pendingSounds;
+    std::map<std::string, sf::Image> _decodedImages;   // by path, dropped once textures exist
+    size_t _loadSteps{ 0 };
+    size_t _loadStepsDone{ 0 };
+    bool _texturesReady{ true };
+    bool _loading{ false };
+    bool _headless{ false };
+
+    // mapped for the lifetime of the game, fonts read straight out of it
+    AssetPack _pack;
 
     Assets() = default;
 
+    void loadFromPack(const std::string& path);
+    void parseConfig(std::istream& config);
+    void readBudget();
+    void parseValue(std::istringstream& iss, std::string token);
+    void loadFont(const std::string& name, const std::string& path);
+    void queueImage(const std::string& path);
+    void queueSound(SoundId id);
+    void startTextureLoading();
+    void pollLoading();
+    void finishTextures();
+    void addStandaloneTexture(const TextureSource& source, const sf::Image& image);
+    bool readAtlasManifest(AtlasLayout& layout) const;
+    bool restoreCachedAtlas();
+    void buildAtlas(const std::vector<TextureSource>& sources);
+    void loadPackedTextures();
+    const TextureRegion* loadTexture(TextureId id);
+    const sf::SoundBuffer* loadSound(SoundId id);
+
+    void markResident(Residency& residency, ResidencyStats& stats, size_t bytes);
+    void markEvicted(Residency& residency, ResidencyStats& stats);
+    void addPinnedBytes(sf::Vector2u pageSize);
+    const sf::Texture* atlasPage(int page) const { return _headless ? nullptr : &_atlasPages[page]; }
+    bool isResident(TextureId id) const;
+    void touch(Residency& residency) { residency.lastUse = ++_useClock; }
+    void enforceBudget();
+
     void logAssetLoaded(const std::string& type, const std::string& name, const std::string& path) const {
         std::cout << "Loaded " << type << ": " << name << " from " << path << std::endl;
 
@@ -30,14 +161,102 @@ public:
         return instance;
     }
 
+    // Values and fonts are ready when this returns, textures and sounds are
+    // decoded on worker threads. Call update() from the render thread until
+    // isLoaded() before asking for either. A pack written by AssetPacker can
+    // be passed instead of config.txt, nothing needs decoding then.
     void loadFromFile(const std::string& path);
 
-    const sf::Texture& getTexture(const std::string& name) const;
-    const sf::Font& getFont(const std::string& name) const;
-    const sf::SoundBuffer& getSoundBuffer(const std::string& name) const;
+    // Set before loadFromFile when there is no display or audio device: textures
+    // keep their regions and sizes but have no sf::Texture behind them (the
+    // region's texture is null), and sounds are not decoded at all.
+    void setHeadless(bool headless) { _headless = headless; }
+    bool isHeadless() const { return _headless; }
+
+    // Once per frame: finishes background loading, then evicts unreferenced
+    // assets, least recently used first, while over AssetBudgetMB. Anything
+    // not held through a TextureRef/SoundRef is only valid until the next call.
+    void update();
+    bool isLoaded() const { return !_loading; }
+    float getLoadProgress() const;
+    bool reloadValues(const std::string& path);
+
+    // bumped whenever reloadValues changed something
+    unsigned int getRevision() const { return _revision; }
+
+    // Resolve names once and keep the id, lookups by id are an array index.
+    // Unknown names give an invalid id, which the getters answer with an empty asset.
+    TextureId textureId(const std::string& name) const;
+    FontId fontId(const std::string& name) const;
+    SoundId soundId(const std::string& name) const;
+    const std::string& getName(TextureId id) const { return _textureRegions.getName(id); }
+    const std::string& getName(FontId id) const { return _fonts.getName(id); }
+    const std::string& getName(SoundId id) const { return _soundBuffers.getName(id); }
+
+    // atlas page (or standalone texture) plus the sub-rect holding the image
+    const TextureRegion& getTexture(TextureId id);
+    const sf::Font& getFont(FontId id) const;
+
+    // not available headless, where SoundPlayer never plays anything
+    const sf::SoundBuffer& getSoundBuffer(SoundId id);
+
+    // by name, for one-off lookups and tools
+    const TextureRegion& getTexture(const std::string& name) { return getTexture(textureId(name)); }
+    const sf::Font& getFont(const std::string& name) const { return getFont(fontId(name)); }
+    const sf::SoundBuffer& getSoundBuffer(const std::string& name) { return getSoundBuffer(soundId(name)); }
+
+    // reference counts behind TextureRef and SoundRef
+    void acquire(TextureId id);
+    void release(TextureId id);
+    void acquire(SoundId id);
+    void release(SoundId id);
+
+    const ResidencyStats& getTextureStats() const { return _textureStats; }
+    const ResidencyStats& getSoundStats() const { return _soundStats; }
+    size_t getBudget() const { return _budgetBytes; }
 
     float getFloat(const std::string& name, float defaultValue = 0.0f) const;
     int getInt(const std::string& name, int defaultValue = 0) const;
     const std::string& getString(const std::string& name, const std::string& defaultValue = "") const;
     sf::Vector2f getVector(const std::string& name, const sf::Vector2f& defaultValue = { 0, 0 }) const;
 };
+
+
+// Keeps a texture or sound resident while alive, copies hold their own
+// reference. Sprites and sounds set up from it stay valid just as long.
+template<typename Id>
+class AssetRef {
+private:
+    Id m_id;
+
+public:
+    AssetRef() = default;
+    explicit AssetRef(Id id) : m_id(id) { Assets::getInstance().acquire(m_id); }
+    explicit AssetRef(const std::string& name) : AssetRef(resolve(name)) {}
+    AssetRef(const AssetRef& other) : AssetRef(other.m_id) {}
+    AssetRef(AssetRef&& other) noexcept : m_id(std::exchange(other.m_id, Id{})) {}
+    AssetRef& operator=(AssetRef other) noexcept { std::swap(m_id, other.m_id); return *this; }
+    ~AssetRef() { Assets::getInstance().release(m_id); }
+
+    Id getId() const { return m_id; }
+
+    decltype(auto) get() const {
+        if constexpr (std::is_same_v<Id, TextureId>)
+            return Assets::getInstance().getTexture(m_id);
+        else
+            return Assets::getInstance().getSoundBuffer(m_id);
+    }
+    decltype(auto) operator*() const { return get(); }
+    auto operator->() const { return &get(); }
+
+private:
+    static Id resolve(const std::string& name) {
+        if constexpr (std::is_same_v<Id, TextureId>)
+            return Assets::getInstance().textureId(name);
+        else
+            return Assets::getInstance().soundId(name);
+    }
+};
+
+using TextureRef = AssetRef<TextureId>;
+using SoundRef   = AssetRef<SoundId>;
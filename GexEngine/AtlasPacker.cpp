@@ -0,0 +1,79 @@
+#include "AtlasPacker.h"
+#include <algorithm>
+#include <limits>
+
+AtlasPacker::AtlasPacker(sf::Vector2u size, unsigned padding)
+    : m_size(size), m_padding(padding) {
+    m_skyline.push_back(Segment{ 0, 0, size.x });
+}
+
+// y is the lowest top edge a rect starting at this segment can sit on
+bool AtlasPacker::fits(std::size_t segment, unsigned width, unsigned height, unsigned& y) const {
+    unsigned x = m_skyline[segment].x;
+    if (x + width > m_size.x)
+        return false;
+
+    y = 0;
+    unsigned covered = 0;
+    for (size_t i = segment; covered < width; ++i) {
+        y = std::max(y, m_skyline[i].y);
+        if (y + height > m_size.y)
+            return false;
+        covered += m_skyline[i].width;
+    }
+    return true;
+}
+
+void AtlasPacker::place(std::size_t segment, unsigned x, unsigned y, unsigned width, unsigned height) {
+    m_skyline.insert(m_skyline.begin() + segment, Segment{ x, y + height, width });
+
+    // cut away whatever the new segment now shadows
+    size_t i = segment + 1;
+    while (i < m_skyline.size() && m_skyline[i].x < x + width) {
+        unsigned shadow = x + width - m_skyline[i].x;
+        if (shadow < m_skyline[i].width) {
+            m_skyline[i].x += shadow;
+            m_skyline[i].width -= shadow;
+            break;
+        }
+        m_skyline.erase(m_skyline.begin() + i);
+    }
+
+    for (size_t j = 0; j + 1 < m_skyline.size();) {
+        if (m_skyline[j].y == m_skyline[j + 1].y) {
+            m_skyline[j].width += m_skyline[j + 1].width;
+            m_skyline.erase(m_skyline.begin() + j + 1);
+        }
+        else {
+            ++j;
+        }
+    }
+}
+
+bool AtlasPacker::insert(sf::Vector2u size, sf::Vector2u& position) {
+    unsigned width = size.x + m_padding;
+    unsigned height = size.y + m_padding;
+
+    size_t best = m_skyline.size();
+    unsigned bestY = 0;
+    unsigned bestBottom = std::numeric_limits<unsigned>::max();
+
+    for (size_t i = 0; i < m_skyline.size(); ++i) {
+        unsigned y;
+        if (fits(i, width, height, y) && y + height < bestBottom) {
+            best = i;
+            bestY = y;
+            bestBottom = y + height;
+        }
+    }
+
+    if (best == m_skyline.size())
+        return false;
+
+    position = sf::Vector2u(m_skyline[best].x, bestY);
+    place(best, position.x, position.y, width, height);
+
+    m_used.x = std::max(m_used.x, position.x + size.x);
+    m_used.y = std::max(m_used.y, position.y + size.y);
+    return true;
+}
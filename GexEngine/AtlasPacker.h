@@ -0,0 +1,34 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+
+// Skyline bottom-left rectangle packer for one atlas page. Each rect is
+// placed where its top edge ends up lowest, so feeding it the tallest
+// rects first keeps the skyline flat. Padding is kept to the right of and
+// below every rect so filtering doesn't bleed between neighbours.
+class AtlasPacker {
+private:
+    struct Segment {
+        unsigned x;
+        unsigned y;
+        unsigned width;
+    };
+
+    sf::Vector2u            m_size;
+    unsigned                m_padding;
+    std::vector<Segment>    m_skyline;
+    sf::Vector2u            m_used{ 0, 0 };
+
+    bool fits(std::size_t segment, unsigned width, unsigned height, unsigned& y) const;
+    void place(std::size_t segment, unsigned x, unsigned y, unsigned width, unsigned height);
+
+public:
+    AtlasPacker(sf::Vector2u size, unsigned padding);
+
+    // false when the page has no room left for size
+    bool insert(sf::Vector2u size, sf::Vector2u& position);
+
+    // smallest page that still holds every placed rect
+    sf::Vector2u getUsedSize() const { return m_used; }
+};
@@ -1,18 +1,19 @@
 #include "BackgroundScene.h"
+#include "Assets.h"
 #include <iostream>
 
-BackgroundScene::BackgroundScene(const std::string& backgroundPath) {
-    std::string fullPath = "../assets/" + backgroundPath;
-
-    if (!backgroundTexture.loadFromFile(fullPath)) {
-        std::cerr << "Failed to load background image: " << fullPath << "\n";
+BackgroundScene::BackgroundScene(const std::string& textureName)
+    : backgroundTexture(textureName) {
+    const TextureRegion& region = *backgroundTexture;
+    if (region.rect.width == 0 || region.rect.height == 0) {
+        std::cerr << "Failed to load background image: " << textureName << "\n";
     }
     else {
-        backgroundSprite.setTexture(backgroundTexture);
+        region.applyTo(backgroundSprite);
 
         sf::Vector2u windowSize = sf::Vector2u(1280, 768);
 
-        sf::Vector2u textureSize = backgroundTexture.getSize();
+        sf::Vector2u textureSize = region.getSize();
 
         float scaleX = static_cast<float>(windowSize.x) / textureSize.x;
         float scaleY = static_cast<float>(windowSize.y) / textureSize.y;
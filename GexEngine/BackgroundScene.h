@@ -1,14 +1,16 @@
 #pragma once
 #include "Scene.h"
+#include "Assets.h"
 #include <SFML/Graphics.hpp>
 
+// Full window backdrop drawn from a texture in the Assets cache.
 class BackgroundScene : public Scene {
 private:
-    sf::Texture backgroundTexture;
+    TextureRef backgroundTexture;
     sf::Sprite backgroundSprite;
 
 public:
-    BackgroundScene(const std::string& backgroundPath);
+    BackgroundScene(const std::string& textureName);
 
     void update(sf::Time dt) override {}
     void sRender() override;
@@ -0,0 +1,97 @@
+#ifndef BREAKOUT_COMPONENTPOOL_H
+#define BREAKOUT_COMPONENTPOOL_H
+
+
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+
+#include "Entity.h"
+
+
+// Sparse set holding one component type. Components are packed densely in
+// m_data, so an entity only pays for the components it actually owns and a
+// system can walk every T without touching entities that lack one.
+template<typename T>
+class ComponentPool
+{
+private:
+    static constexpr std::uint32_t npos = 0xFFFFFFFFu;
+
+    std::vector<std::uint32_t>  m_sparse;       // slot index -> dense index
+    std::vector<EntityId>       m_dense;        // dense index -> owner
+    std::vector<T>              m_data;         // parallel to m_dense
+
+public:
+
+    bool contains(EntityId id) const {
+        auto index = EntityHandle::index(id);
+        return index < m_sparse.size()
+            && m_sparse[index] != npos
+            && m_dense[m_sparse[index]] == id;
+    }
+
+
+    T& insert(EntityId id, T&& component) {
+        if (contains(id))
+            return m_data[m_sparse[EntityHandle::index(id)]] = std::move(component);
+
+        auto index = EntityHandle::index(id);
+        if (index >= m_sparse.size())
+            m_sparse.resize(index + 1, npos);
+
+        m_sparse[index] = static_cast<std::uint32_t>(m_dense.size());
+        m_dense.push_back(id);
+        m_data.push_back(std::move(component));
+        return m_data.back();
+    }
+
+
+    // swap-and-pop keeps m_data packed
+    void remove(EntityId id) {
+        if (!contains(id))
+            return;
+
+        auto index = EntityHandle::index(id);
+        auto hole = m_sparse[index];
+        auto last = static_cast<std::uint32_t>(m_dense.size() - 1);
+
+        if (hole != last) {
+            m_dense[hole] = m_dense[last];
+            m_data[hole] = std::move(m_data[last]);
+            m_sparse[EntityHandle::index(m_dense[hole])] = hole;
+        }
+
+        m_dense.pop_back();
+        m_data.pop_back();
+        m_sparse[index] = npos;
+    }
+
+
+    // the entity must own a T, check contains() first when it may not
+    T& get(EntityId id) {
+        assert(contains(id) && "component missing, check contains() first");
+        return m_data[m_sparse[EntityHandle::index(id)]];
+    }
+
+    const T& get(EntityId id) const {
+        assert(contains(id) && "component missing, check contains() first");
+        return m_data[m_sparse[EntityHandle::index(id)]];
+    }
+
+
+    size_t                          size() const        { return m_dense.size(); }
+    const std::vector<EntityId>&    entities() const    { return m_dense; }
+    std::vector<T>&                 components()        { return m_data; }
+    const std::vector<T>&           components() const  { return m_data; }
+
+    void reserve(size_t count) {
+        m_dense.reserve(count);
+        m_data.reserve(count);
+    }
+};
+
+
+
+#endif //BREAKOUT_COMPONENTPOOL_H
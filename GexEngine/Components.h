@@ -3,8 +3,10 @@
 
 
 #include <memory>
+#include <cmath>
 #include <SFML/Graphics.hpp>
 #include "Utilities.h"
+#include "TextureRegion.h"
 
 
 
@@ -33,22 +35,76 @@ struct CShape : public Component
 };
 
 
+// Position, scale, rotation and origin go through setters so the world matrix
+// and the world-space AABB are only rebuilt after one of them really changed.
 struct CTransform : public Component
 {
-
-    sf::Transformable  tfm;
-    sf::Vector2f	pos			{ 0.f, 0.f };
     sf::Vector2f	vel			{ 0.f, 0.f };
-    sf::Vector2f	scale		{ 1.f, 1.f };
-
     float   angVel{ 0 };
-    float	angle{ 0.f };
 
     CTransform() = default;
-    CTransform(const sf::Vector2f& p) : pos(p)  {}
+    CTransform(const sf::Vector2f& p) : m_pos(p), m_prev(p)  {}
     CTransform(const sf::Vector2f& p, const sf::Vector2f& v)
-            : pos(p),  vel(v){}
+            : vel(v), m_pos(p), m_prev(p) {}
+
+    const sf::Vector2f&     getPosition() const     { return m_pos; }
+    const sf::Vector2f&     getScale() const        { return m_scale; }
+    const sf::Vector2f&     getOrigin() const       { return m_origin; }
+    float                   getRotation() const     { return m_angle; }
+    const sf::FloatRect&    getLocalBounds() const  { return m_local; }
+
+    void setPosition(const sf::Vector2f& p)         { if (p != m_pos) { m_pos = p; m_dirty = true; } }
+    void move(const sf::Vector2f& d)                { if (d.x != 0.f || d.y != 0.f) { m_pos += d; m_dirty = true; } }
+    void setScale(const sf::Vector2f& s)            { if (s != m_scale) { m_scale = s; m_dirty = true; } }
+    void setOrigin(const sf::Vector2f& o)           { if (o != m_origin) { m_origin = o; m_dirty = true; } }
+    void setRotation(float a)                       { if (a != m_angle) { m_angle = a; m_dirty = true; } }
+    void setLocalBounds(const sf::FloatRect& r)     { if (r != m_local) { m_local = r; m_dirty = true; } }
+
+    const sf::Transform& getTransform() const {
+        if (m_dirty) rebuild();
+        return m_world;
+    }
 
+    const sf::FloatRect& getGlobalBounds() const {
+        if (m_dirty) rebuild();
+        return m_bounds;
+    }
+
+    // position at the start of the tick, so rendering can draw in between;
+    // offset from the current position at alpha 0..1 of the way to it
+    void savePrevious()                             { m_prev = m_pos; }
+    sf::Vector2f getRenderOffset(float alpha) const { return (m_prev - m_pos) * (1.f - alpha); }
+
+private:
+    sf::Vector2f	m_pos		{ 0.f, 0.f };
+    sf::Vector2f	m_prev		{ 0.f, 0.f };
+    sf::Vector2f	m_scale		{ 1.f, 1.f };
+    sf::Vector2f	m_origin	{ 0.f, 0.f };
+    float			m_angle		{ 0.f };
+    sf::FloatRect	m_local;
+
+    mutable sf::Transform	m_world;
+    mutable sf::FloatRect	m_bounds;
+    mutable bool			m_dirty{ true };
+
+    // same matrix sf::Transformable::getTransform builds
+    void rebuild() const {
+        float rad = -m_angle * 3.141592654f / 180.f;
+        float cosine = std::cos(rad);
+        float sine = std::sin(rad);
+        float sxc = m_scale.x * cosine;
+        float syc = m_scale.y * cosine;
+        float sxs = m_scale.x * sine;
+        float sys = m_scale.y * sine;
+        float tx = -m_origin.x * sxc - m_origin.y * sys + m_pos.x;
+        float ty = m_origin.x * sxs - m_origin.y * syc + m_pos.y;
+
+        m_world = sf::Transform(sxc, sys, tx,
+                                -sxs, syc, ty,
+                                0.f, 0.f, 1.f);
+        m_bounds = m_world.transformRect(m_local);
+        m_dirty = false;
+    }
 };
 
 struct CName : public Component {
@@ -110,18 +166,19 @@ struct CCar : public Component {
 
 struct CCollectible : public Component {
     enum Type { Bone, Cookie };
-    Type type;
+    Type type{ Bone };
 
     CCollectible() { has = true; }
     CCollectible(Type t) : type(t) { has = true; }
 };
 
+// drawn with the entity's CTransform, the sprite's own transform stays identity
 struct CSprite : public Component {
     sf::Sprite sprite;
 
     CSprite() { has = true; }
-    CSprite(const sf::Texture& texture) {
-        sprite.setTexture(texture);
+    CSprite(const TextureRegion& region) {
+        region.applyTo(sprite);
         has = true;
     }
 };
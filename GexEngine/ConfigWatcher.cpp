@@ -0,0 +1,69 @@
+#include "ConfigWatcher.h"
+#include <iostream>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+ConfigWatcher::ConfigWatcher(const std::string& path)
+    : m_path(path) {
+    std::filesystem::path file(path);
+    m_fileName = file.filename().string();
+
+    std::error_code ec;
+    m_lastWrite = std::filesystem::last_write_time(file, ec);
+
+#ifdef __linux__
+    // watch the directory, editors often save by renaming a temp file over the original
+    auto directory = file.parent_path().empty() ? std::filesystem::path(".") : file.parent_path();
+    m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotify >= 0 && inotify_add_watch(m_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(m_inotify);
+        m_inotify = -1;
+    }
+    if (m_inotify < 0)
+        std::cerr << "inotify unavailable, polling " << path << " instead\n";
+#endif
+}
+
+ConfigWatcher::~ConfigWatcher() {
+#ifdef __linux__
+    if (m_inotify >= 0)
+        close(m_inotify);
+#endif
+}
+
+bool ConfigWatcher::changed() {
+#ifdef __linux__
+    if (m_inotify >= 0) {
+        alignas(inotify_event) char buffer[4096];
+        bool touched = false;
+        ssize_t length;
+        while ((length = read(m_inotify, buffer, sizeof(buffer))) > 0) {
+            for (char* p = buffer; p < buffer + length;) {
+                auto* event = reinterpret_cast<inotify_event*>(p);
+                if (event->len > 0 && m_fileName == event->name)
+                    touched = true;
+                p += sizeof(inotify_event) + event->len;
+            }
+        }
+        return touched;
+    }
+#endif
+    return pollWriteTime();
+}
+
+bool ConfigWatcher::pollWriteTime() {
+    if (m_pollClock.getElapsedTime() < sf::seconds(0.5f))
+        return false;
+    m_pollClock.restart();
+
+    std::error_code ec;
+    auto lastWrite = std::filesystem::last_write_time(m_path, ec);
+    if (ec || lastWrite == m_lastWrite)
+        return false;
+
+    m_lastWrite = lastWrite;
+    return true;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <SFML/System/Clock.hpp>
+#include <filesystem>
+#include <string>
+
+// Tells the game loop when a config file was written. Uses inotify on Linux,
+// so the per-frame check is one non-blocking read; other platforms poll the
+// modification time twice a second.
+class ConfigWatcher {
+private:
+    std::string                     m_path;
+    std::string                     m_fileName;
+    std::filesystem::file_time_type m_lastWrite{};
+    sf::Clock                       m_pollClock;
+    int                             m_inotify{ -1 };
+
+    bool pollWriteTime();
+
+public:
+    explicit ConfigWatcher(const std::string& path);
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    // true once for every batch of writes since the last call
+    bool changed();
+};
@@ -1,22 +1,27 @@
 #include "Entity.h"
+#include "EntityManager.h"
 
-Entity::Entity(size_t id, const std::string &tag)
-        : m_tag(tag), m_id(id) {
+Entity::Entity(EntityManager* manager, EntityId id)
+        : m_manager(manager), m_id(id) {
 
 }
 
 void Entity::destroy() {
-    m_active = false;
+    m_manager->destroyEntity(m_id);
 }
 
-const size_t &Entity::getId() const {
+EntityId Entity::getId() const {
     return m_id;
 }
 
 const std::string &Entity::getTag() const {
-    return m_tag;
+    return m_manager->getTag(m_id);
+}
+
+TagId Entity::getTagId() const {
+    return m_manager->getTagId(m_id);
 }
 
 bool Entity::isActive() const {
-    return m_active;
+    return m_manager && m_manager->isActive(m_id);
 }
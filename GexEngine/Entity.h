@@ -4,62 +4,71 @@
 
 #include <tuple>
 #include <string>
+#include <cstdint>
 
 #include "Components.h"
 class EntityManager;
 
-using ComponentTuple = std::tuple<CShape,  CTransform, CCollision, CInput, CName>;
+using ComponentTuple = std::tuple<CShape,  CTransform, CCollision, CInput, CName, CCar, CCollectible, CSprite>;
 
+// 32-bit generational handle: low bits index a slot in the EntityManager's
+// component arrays, high bits count how many times that slot was reused.
+using EntityId = std::uint32_t;
+
+// tags are interned by EntityManager::registerTag into small dense ids
+using TagId = std::uint16_t;
+
+namespace EntityHandle {
+    constexpr std::uint32_t IndexBits       = 20;
+    constexpr std::uint32_t IndexMask       = (1u << IndexBits) - 1;
+    constexpr std::uint32_t GenerationMask  = (1u << (32 - IndexBits)) - 1;
+
+    inline std::uint32_t index(EntityId id)         { return id & IndexMask; }
+    inline std::uint32_t generation(EntityId id)    { return id >> IndexBits; }
+    inline EntityId make(std::uint32_t index, std::uint32_t generation) {
+        return ((generation & GenerationMask) << IndexBits) | (index & IndexMask);
+    }
+}
+
+
+// Lightweight value handle; all component data lives in the EntityManager.
 class Entity {
 private:
     friend class EntityManager;
-    Entity(size_t id, const std::string &tag);      
+    Entity(EntityManager* manager, EntityId id);
 
-    const size_t            m_id{0};
-    const std::string       m_tag{"Default"};
-    bool                    m_active{true};
-    ComponentTuple          m_components;
+    EntityManager*          m_manager{nullptr};
+    EntityId                m_id{0};
 
 public:
+    Entity() = default;
 
     void                    destroy();
-    const size_t&           getId() const;
+    EntityId                getId() const;
     const std::string&      getTag() const;
+    TagId                   getTagId() const;
     bool                    isActive() const;
 
 
-
+    // defined in EntityManager.h, they forward to the component arrays
     template<typename T>
-    inline bool hasComponent() const {
-        return getComponent<T>().has;
-    }
-
+    bool hasComponent() const;
 
     template<typename T, typename... TArgs>
-    inline T &addComponent(TArgs &&... mArgs) {
-        auto &component = getComponent<T>();
-        component = T(std::forward<TArgs>(mArgs)...);
-        component.has = true;
-        return component;
-    }
-
+    T& addComponent(TArgs &&... mArgs);
 
     template<typename T>
-    inline bool removeComponent() const {
-        return getComponent<T>().has = false;
-    }
-
+    void removeComponent();
 
+    // the entity must have a T, see hasComponent
     template<typename T>
-    inline T &getComponent() {
-        return std::get<T>(m_components);
-    }
-
+    T& getComponent();
 
     template<typename T>
-    inline const T &getComponent() const {
-        return std::get<T>(m_components);
-    }
+    const T& getComponent() const;
+
+    bool operator==(const Entity& other) const { return m_id == other.m_id && m_manager == other.m_manager; }
+    bool operator!=(const Entity& other) const { return !(*this == other); }
 };
 
 
@@ -1,42 +1,185 @@
 #include "EntityManager.h"
 #include "Entity.h"
+#include <limits>
+#include <stdexcept>
 
-EntityManager::EntityManager() : m_totalEntities(0)  {}
+namespace {
+    // slot has not been moved from m_EntitiesToAdd into the lists yet
+    const std::uint32_t NotListed = 0xFFFFFFFFu;
+}
+
+EntityManager::EntityManager() {}
+
+
+TagId EntityManager::registerTag(const std::string &tag) {
+    auto found = m_tagIds.find(tag);
+    if (found != m_tagIds.end())
+        return found->second;
+
+    // a wider count would wrap around and share a bucket with tag 0
+    if (m_tagNames.size() > std::numeric_limits<TagId>::max())
+        throw std::length_error("EntityManager: more than 2^16 tags");
+    auto id = static_cast<TagId>(m_tagNames.size());
+    m_tagIds.emplace(tag, id);
+    m_tagNames.push_back(tag);
+    m_tagBuckets.emplace_back();
+    return id;
+}
+
+
+const std::string &EntityManager::getTagName(TagId tag) const {
+    return m_tagNames[tag];
+}
+
+
+Entity EntityManager::addEntity(TagId tag) {
+    auto index = allocateSlot();
+    m_tags[index] = tag;
+    m_active[index] = true;
+
+    Entity e(this, EntityHandle::make(index, m_generations[index]));
+    m_EntitiesToAdd.push_back(e);
+    return e;
+}
+
+
+Entity EntityManager::addEntity(const std::string &tag) {
+    return addEntity(registerTag(tag));
+}
 
 
-std::shared_ptr<Entity> EntityManager::addEntity(const std::string &tag) {
-    auto e = std::shared_ptr<Entity>(new Entity(m_totalEntities++, tag));   
-    m_EntitiesToAdd.push_back(e);       
-    return e;                           
+EntityVec &EntityManager::getEntities(TagId tag) {
+    return m_tagBuckets[tag];
 }
 
 
-EntityVec &EntityManager::getEntities(const std::string &tag) {
-    return m_entityMap[tag];
+// unknown tags yield an empty list instead of creating a bucket
+const EntityVec &EntityManager::getEntities(const std::string &tag) const {
+    static const EntityVec empty;
+    auto found = m_tagIds.find(tag);
+    return (found == m_tagIds.end()) ? empty : m_tagBuckets[found->second];
 }
 
 
 void EntityManager::update() {
 
-    removeDeadEntities(m_entities);
-    for (auto& [_, entityVec] : m_entityMap)
-        removeDeadEntities(entityVec);
-     
+    // cost is proportional to the number of deaths, not to the entity count
+    for (auto id : m_deadEntities)
+        removeDeadEntity(id);
+    m_deadEntities.clear();
 
+    // entities destroyed while still pending were released above
     for (auto e : m_EntitiesToAdd)
     {
+        if (!e.isActive())
+            continue;
+
+        auto index = EntityHandle::index(e.getId());
+        auto& bucket = m_tagBuckets[m_tags[index]];
+        m_entityPos[index] = static_cast<std::uint32_t>(m_entities.size());
+        m_bucketPos[index] = static_cast<std::uint32_t>(bucket.size());
         m_entities.push_back(e);
-        m_entityMap[e->getTag()].push_back(e);
+        bucket.push_back(e);
     }
     m_EntitiesToAdd.clear();
 }
 
 
+void EntityManager::reserve(size_t count) {
+    std::apply([count](auto&... pool) { (pool.reserve(count), ...); }, m_pools);
+    m_tags.reserve(count);
+    m_generations.reserve(count);
+    m_active.reserve(count);
+    m_entityPos.reserve(count);
+    m_bucketPos.reserve(count);
+    m_entities.reserve(count);
+}
+
+
 EntityVec &EntityManager::getEntities() {
     return m_entities;
 }
 
 
-void EntityManager::removeDeadEntities(EntityVec &v) {
-    v.erase(std::remove_if(v.begin(), v.end(), [](auto e) {return!(e->isActive()); }), v.end());
+bool EntityManager::isActive(EntityId id) const {
+    auto index = EntityHandle::index(id);
+    return index < m_generations.size()
+        && m_generations[index] == EntityHandle::generation(id)
+        && m_active[index];
+}
+
+
+void EntityManager::destroyEntity(EntityId id) {
+    if (!isActive(id))
+        return;
+
+    m_active[EntityHandle::index(id)] = false;
+    m_deadEntities.push_back(id);
+}
+
+
+const std::string &EntityManager::getTag(EntityId id) const {
+    return m_tagNames[m_tags[EntityHandle::index(id)]];
+}
+
+
+TagId EntityManager::getTagId(EntityId id) const {
+    return m_tags[EntityHandle::index(id)];
+}
+
+
+Entity EntityManager::getEntity(EntityId id) {
+    return Entity(this, id);
+}
+
+
+std::uint32_t EntityManager::allocateSlot() {
+    if (!m_freeSlots.empty()) {
+        auto index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        return index;
+    }
+
+    // one more slot would alias index 0 in EntityHandle::make
+    auto index = static_cast<std::uint32_t>(m_generations.size());
+    if (index > EntityHandle::IndexMask)
+        throw std::length_error("EntityManager: more than 2^20 live entities");
+    m_tags.push_back(0);
+    m_generations.push_back(0);
+    m_active.push_back(false);
+    m_entityPos.push_back(NotListed);
+    m_bucketPos.push_back(NotListed);
+    return index;
+}
+
+
+// drop the entity's components and bump the slot generation so stale handles die
+void EntityManager::releaseSlot(EntityId id) {
+    std::apply([id](auto&... pool) { (pool.remove(id), ...); }, m_pools);
+
+    auto index = EntityHandle::index(id);
+    m_active[index] = false;
+    m_generations[index] = (m_generations[index] + 1) & EntityHandle::GenerationMask;
+    m_freeSlots.push_back(index);
+}
+
+
+// swap-and-pop out of m_entities and the tag bucket, then recycle the slot
+void EntityManager::removeDeadEntity(EntityId id) {
+    auto index = EntityHandle::index(id);
+
+    auto unlist = [](EntityVec& v, std::vector<std::uint32_t>& positions, std::uint32_t index) {
+        auto pos = positions[index];
+        if (pos == NotListed)
+            return;
+
+        v[pos] = v.back();
+        positions[EntityHandle::index(v[pos].getId())] = pos;
+        v.pop_back();
+        positions[index] = NotListed;
+    };
+
+    unlist(m_entities, m_entityPos, index);
+    unlist(m_tagBuckets[m_tags[index]], m_bucketPos, index);
+    releaseSlot(id);
 }
@@ -2,38 +2,201 @@
 #define BREAKOUT_ENTITYMANAGER_H
 
 
-#include <map>
-#include <vector>h
+#include <vector>
+#include <unordered_map>
 #include <string>
-#include <memory>
+#include <tuple>
+#include <cstdint>
 
-//forward declare
-class Entity;
+#include "Entity.h"
+#include "ComponentPool.h"
 
-using sPtrEntt  = std::shared_ptr<Entity>;
-using EntityVec = std::vector<std::shared_ptr<Entity>>;
-using EntityMap = std::map <std::string, EntityVec>;
+using EntityVec = std::vector<Entity>;
+using TagIndex  = std::unordered_map<std::string, TagId>;
+
+// one sparse-set pool per component type in ComponentTuple
+template<typename Tuple> struct ComponentPoolsOf;
+template<typename... Ts> struct ComponentPoolsOf<std::tuple<Ts...>> {
+    using type = std::tuple<ComponentPool<Ts>...>;
+};
+using ComponentPools = ComponentPoolsOf<ComponentTuple>::type;
+
+template<typename... Ts>
+class EntityView;
 
 
 class EntityManager
 {
 private:
+    // per-slot arrays are indexed by EntityHandle::index(id),
+    // component data is packed per type in m_pools
+    ComponentPools              m_pools;
+    std::vector<TagId>          m_tags;
+    std::vector<std::uint32_t>  m_generations;
+    std::vector<bool>           m_active;
+    std::vector<std::uint32_t>  m_entityPos;        // position in m_entities
+    std::vector<std::uint32_t>  m_bucketPos;        // position in the tag bucket
+    std::vector<std::uint32_t>  m_freeSlots;
+    std::vector<EntityId>       m_deadEntities;     // destroyed since the last update
+
+    // tag buckets are indexed by TagId, names are only looked up on registration
+    TagIndex                    m_tagIds;
+    std::vector<std::string>    m_tagNames;
+    std::vector<EntityVec>      m_tagBuckets;
+
     EntityVec	    m_entities;
-    EntityMap	    m_entityMap;
-    size_t		    m_totalEntities{0};
     EntityVec	    m_EntitiesToAdd;
 
-    void		    removeDeadEntities(EntityVec& v);
+    void		    removeDeadEntity(EntityId id);
+    std::uint32_t   allocateSlot();
+    void            releaseSlot(EntityId id);
 
 public:
     EntityManager();
 
-    std::shared_ptr<Entity>         addEntity(const std::string& tag);
+    TagId                           registerTag(const std::string& tag);
+    const std::string&              getTagName(TagId tag) const;
+
+    Entity                          addEntity(TagId tag);
+    Entity                          addEntity(const std::string& tag);
     EntityVec&                      getEntities();
-    EntityVec&                      getEntities(const std::string& tag);
+    EntityVec&                      getEntities(TagId tag);
+    const EntityVec&                getEntities(const std::string& tag) const;
 
     void                            update();
+    void                            reserve(size_t count);
+
+    bool                            isActive(EntityId id) const;
+    void                            destroyEntity(EntityId id);
+    const std::string&              getTag(EntityId id) const;
+    TagId                           getTagId(EntityId id) const;
+    Entity                          getEntity(EntityId id);
+
+
+    // whole pool, for systems that walk one component type linearly
+    template<typename T>
+    inline ComponentPool<T>& getComponents() {
+        return std::get<ComponentPool<T>>(m_pools);
+    }
+
+    template<typename T>
+    inline const ComponentPool<T>& getComponents() const {
+        return std::get<ComponentPool<T>>(m_pools);
+    }
+
+    template<typename T>
+    inline bool hasComponent(EntityId id) const {
+        return getComponents<T>().contains(id);
+    }
+
+    template<typename T>
+    inline T& addComponent(EntityId id, T&& component) {
+        component.has = true;
+        return getComponents<T>().insert(id, std::move(component));
+    }
+
+    template<typename T>
+    inline void removeComponent(EntityId id) {
+        getComponents<T>().remove(id);
+    }
+
+    template<typename T>
+    inline T& getComponent(EntityId id) {
+        return getComponents<T>().get(id);
+    }
+
+    template<typename T>
+    inline const T& getComponent(EntityId id) const {
+        return getComponents<T>().get(id);
+    }
+
+
+    // entities owning every one of Ts, e.g.
+    //   for (auto [e, tfm, col] : view<CTransform, CCollision>())
+    template<typename... Ts>
+    inline EntityView<Ts...> view() {
+        return EntityView<Ts...>(this, getComponents<Ts>()...);
+    }
 };
 
 
+// Walks the smallest of the requested pools and yields the entities that are
+// present in all of them. Adding or removing Ts while iterating invalidates it.
+template<typename... Ts>
+class EntityView
+{
+private:
+    EntityManager*                      m_manager;
+    std::tuple<ComponentPool<Ts>*...>   m_pools;
+    const std::vector<EntityId>*        m_driver{nullptr};
+
+    bool matches(EntityId id) const {
+        return std::apply([id](auto*... pool) { return (pool->contains(id) && ...); }, m_pools);
+    }
+
+public:
+    class iterator
+    {
+    private:
+        const EntityView*   m_view;
+        size_t              m_pos;
+
+        void skipMismatches() {
+            while (m_pos < m_view->m_driver->size() && !m_view->matches((*m_view->m_driver)[m_pos]))
+                ++m_pos;
+        }
+
+    public:
+        iterator(const EntityView* view, size_t pos) : m_view(view), m_pos(pos) { skipMismatches(); }
+
+        std::tuple<Entity, Ts&...> operator*() const {
+            EntityId id = (*m_view->m_driver)[m_pos];
+            return { m_view->m_manager->getEntity(id), std::get<ComponentPool<Ts>*>(m_view->m_pools)->get(id)... };
+        }
+
+        iterator& operator++() { ++m_pos; skipMismatches(); return *this; }
+        bool operator!=(const iterator& other) const { return m_pos != other.m_pos; }
+        bool operator==(const iterator& other) const { return m_pos == other.m_pos; }
+    };
+
+    EntityView(EntityManager* manager, ComponentPool<Ts>&... pools)
+        : m_manager(manager), m_pools(&pools...) {
+        ((m_driver == nullptr || pools.size() < m_driver->size() ? m_driver = &pools.entities() : m_driver), ...);
+    }
+
+    iterator begin() const  { return iterator(this, 0); }
+    iterator end() const    { return iterator(this, m_driver->size()); }
+};
+
+
+template<typename T>
+inline bool Entity::hasComponent() const {
+    return m_manager->hasComponent<T>(m_id);
+}
+
+
+template<typename T, typename... TArgs>
+inline T& Entity::addComponent(TArgs &&... mArgs) {
+    return m_manager->addComponent<T>(m_id, T(std::forward<TArgs>(mArgs)...));
+}
+
+
+template<typename T>
+inline void Entity::removeComponent() {
+    m_manager->removeComponent<T>(m_id);
+}
+
+
+template<typename T>
+inline T& Entity::getComponent() {
+    return m_manager->getComponent<T>(m_id);
+}
+
+
+template<typename T>
+inline const T& Entity::getComponent() const {
+    return m_manager->getComponent<T>(m_id);
+}
+
+
 #endif //BREAKOUT_ENTITYMANAGER_H
@@ -2,23 +2,56 @@
 #include "Assets.h"	
 #include "Scene_Menu.h"
 #include "Command.h"
+#include "SoundPlayer.h"
+#include "MusicPlayer.h"
 #include <fstream>
 #include <memory>
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 
+namespace {
+	const sf::Time TimePerFrame = sf::seconds(1.0f / 60.f);
+
+	// config numbers are read as floats, seeds below this survive the round trip
+	const std::uint64_t MaxConfigSeed = 1 << 24;
+
+	// leaves a 60 Hz frame a few ms for rendering
+	const float DefaultTickBudgetMs = 12.f;
+}
+
+
+GameEngine::GameEngine(const std::string& configPath, bool headless)
+	: _configPath(configPath), _configWatcher(configPath), _headless(headless) {
+	// no GL context or audio device exists in headless runs
+	Assets::getInstance().setHeadless(_headless);
+	SoundPlayer::getInstance().setEnabled(!_headless);
+	MusicPlayer::getInstance().setEnabled(!_headless);
 
-GameEngine::GameEngine(const std::string& configPath) {
 	Assets::getInstance().loadFromFile(configPath);
 
 	sf::Vector2f windowSize = Assets::getInstance().getVector("WindowSize", sf::Vector2f(1280, 768));
 	std::string windowTitle = Assets::getInstance().getString("WindowTitle", "GEX Engine");
 	int frameRate = Assets::getInstance().getInt("FrameRate", 60);
+	_frameRateLimit = static_cast<unsigned int>(std::max(0, frameRate));
+	_tickBudget = sf::seconds(Assets::getInstance().getFloat("TickBudgetMs", DefaultTickBudgetMs) / 1000.f);
+	_maxCatchUpTicks = static_cast<size_t>(std::max(1, Assets::getInstance().getInt("MaxCatchUpTicks", 5)));
+
+	// put the logged seed in config.txt to play the same run again
+	int seed = Assets::getInstance().getInt("RandomSeed", 0);
+	_random.setSeed(seed > 0 ? static_cast<std::uint64_t>(seed) : 1 + RandomService::randomSeed() % (MaxConfigSeed - 1));
+	std::cout << "Random seed: " << _random.getSeed() << std::endl;
 
-	_window.create(sf::VideoMode(windowSize.x, windowSize.y), windowTitle);
-	_window.setFramerateLimit(frameRate);
+	setViewport(windowSize);
 
-	std::cout << "Game engine initialized with window size: "
+	// a window is a GL resource, even constructing one needs a display
+	if (!_headless) {
+		_window = std::make_unique<sf::RenderWindow>(sf::VideoMode(windowSize.x, windowSize.y), windowTitle);
+	}
+	setSimulationSpeed(static_cast<size_t>(std::max(0, Assets::getInstance().getInt("SimulationSpeed", 1))));
+	setRenderInterval(static_cast<size_t>(std::max(1, Assets::getInstance().getInt("RenderInterval", 1))));
+
+	std::cout << "Game engine initialized " << (_headless ? "headless with viewport size: " : "with window size: ")
 		<< windowSize.x << "x" << windowSize.y << std::endl;
 }
 
@@ -29,7 +62,7 @@ void GameEngine::init(const std::string& path)
 	loadConfigFromFile(path, width, height);
 
 
-	_window.create(sf::VideoMode(width, height), "Not Mario");
+	_window = std::make_unique<sf::RenderWindow>(sf::VideoMode(width, height), "Not Mario");
 
 	_statisticsText.setFont(Assets::getInstance().getFont("main"));
 	_statisticsText.setPosition(15.0f, 5.0f);
@@ -92,42 +125,152 @@ void GameEngine::update()
 
 }
 
+// window events, once per rendered frame
 void GameEngine::sUserInput()
 {
+	if (_headless)
+		return;
+
 	sf::Event event;
-	while (_window.pollEvent(event))
+	while (_window->pollEvent(event))
 	{
 		if (event.type == sf::Event::Closed)
 			quit();
-		if (event.type == sf::Event::KeyPressed || event.type == sf::Event::KeyReleased)
-		{
-			if (currentScene()->getActionMap().contains(event.key.code))
-			{
-				const std::string actionType = (event.type == sf::Event::KeyPressed) ? "START" : "END";
-				currentScene()->doAction(Command(currentScene()->getActionMap().at(event.key.code), actionType));
-			}
-		}
+		// keys come from the input source while one is set
+		if (!_input && (event.type == sf::Event::KeyPressed || event.type == sf::Event::KeyReleased))
+			dispatchKey(event.key.code, event.type == sf::Event::KeyPressed);
+	}
+}
+
+
+// held keys and the input source, once per simulation tick so a journal
+// lines up with the updates it drove
+void GameEngine::sTickInput()
+{
+	if (_input) {
+		_inputEvents.clear();
+		_input->poll(_inputEvents);
+		for (const auto& e : _inputEvents)
+			dispatchKey(e.key, e.pressed);
 	}
 
 	if (currentScene()) {
-		sf::Time frameTime = sf::seconds(1.0f / 60.0f); 
-
-		if (sf::Keyboard::isKeyPressed(sf::Keyboard::W)) {
-			currentScene()->doAction(Command("MOVE_UP", frameTime));
+		if (isKeyPressed(sf::Keyboard::W)) {
+			currentScene()->doAction(Command("MOVE_UP", TimePerFrame));
 		}
-		if (sf::Keyboard::isKeyPressed(sf::Keyboard::S)) {
-			currentScene()->doAction(Command("MOVE_DOWN", frameTime));
+		if (isKeyPressed(sf::Keyboard::S)) {
+			currentScene()->doAction(Command("MOVE_DOWN", TimePerFrame));
 		}
-		if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)) {
-			currentScene()->doAction(Command("MOVE_LEFT", frameTime));
+		if (isKeyPressed(sf::Keyboard::A)) {
+			currentScene()->doAction(Command("MOVE_LEFT", TimePerFrame));
 		}
-		if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) {
-			currentScene()->doAction(Command("MOVE_RIGHT", frameTime));
+		if (isKeyPressed(sf::Keyboard::D)) {
+			currentScene()->doAction(Command("MOVE_RIGHT", TimePerFrame));
 		}
 	}
 }
 
 
+void GameEngine::dispatchKey(sf::Keyboard::Key key, bool pressed)
+{
+	if (currentScene()->getActionMap().contains(key))
+	{
+		const std::string actionType = pressed ? "START" : "END";
+		currentScene()->doAction(Command(currentScene()->getActionMap().at(key), actionType));
+	}
+}
+
+
+void GameEngine::setInputSource(std::unique_ptr<InputSource> input)
+{
+	if (_recorder)
+		_recorder->finish();
+	_recorder = nullptr;
+	_input = std::move(input);
+}
+
+
+void GameEngine::startRecording(const std::string& path)
+{
+	if (_headless) {
+		std::cerr << "Can't record " << path << " in a headless run\n";
+		return;
+	}
+
+	auto recorder = std::make_unique<JournalRecorder>(path, *_window);
+	JournalRecorder* raw = recorder.get();
+	setInputSource(std::move(recorder));
+	_recorder = raw;
+}
+
+
+void GameEngine::beginSession(std::uint64_t seed)
+{
+	if (_recorder)
+		_recorder->begin(seed, sf::Vector2u(_viewportSize));
+}
+
+
+InputSource* GameEngine::inputSource()
+{
+	return _input.get();
+}
+
+
+bool GameEngine::isKeyPressed(sf::Keyboard::Key key) const
+{
+	return _input ? _input->isKeyPressed(key) : sf::Keyboard::isKeyPressed(key);
+}
+
+
+bool GameEngine::isHeadless() const
+{
+	return _headless;
+}
+
+
+void GameEngine::setSimulationSpeed(size_t speed)
+{
+	_simulationSpeed = speed;
+}
+
+
+size_t GameEngine::getSimulationSpeed() const
+{
+	return _simulationSpeed;
+}
+
+
+void GameEngine::setRenderInterval(size_t interval)
+{
+	_renderInterval = std::max<size_t>(interval, 1);
+}
+
+
+float GameEngine::getRenderAlpha() const
+{
+	return _renderAlpha;
+}
+
+
+unsigned int GameEngine::getFrameRate() const
+{
+	return _frameRate;
+}
+
+
+unsigned int GameEngine::getTickRate() const
+{
+	return _tickRate;
+}
+
+
+RandomService& GameEngine::random()
+{
+	return _random;
+}
+
+
 std::shared_ptr<Scene> GameEngine::currentScene()
 {
 	return _sceneMap.at(_currentScene);
@@ -147,32 +290,106 @@ void GameEngine::changeScene(const std::string& sceneName, std::shared_ptr<Scene
 
 void GameEngine::quit()
 {
-	_window.close();
+	_running = false;
+	if (_window && _window->isOpen())
+		_window->close();
 }
 
 
 void GameEngine::run()
 {
-	const sf::Time SPF = sf::seconds(1.0f / 60.f);  
-
 	sf::Clock clock;
+	sf::Clock frameClock;
 	sf::Time timeSinceLastUpdate = sf::Time::Zero;
+	size_t frame = 0;
 
 	while (isRunning())
 	{
-		sUserInput();								
+		// scenes pick up the new values on their next update
+		if (_configWatcher.changed())
+			Assets::getInstance().reloadValues(_configPath);
+
+		// finished sounds drop their buffer references before eviction runs
+		SoundPlayer::getInstance().removeStoppedSounds();
+		Assets::getInstance().update();
+
+		sUserInput();
+
+		sf::Time elapsed = clock.restart();
+		timeSinceLastUpdate += elapsed * static_cast<float>(_simulationSpeed);
 
-		timeSinceLastUpdate += clock.restart();
-		while (timeSinceLastUpdate > SPF)
+		// a hitch (blocking load, window drag) costs at most a few ticks of
+		// catch-up, the rest of the lost time is skipped
+		sf::Time maxBacklog = TimePerFrame * static_cast<float>(_maxCatchUpTicks * std::max<size_t>(_simulationSpeed, 1));
+		timeSinceLastUpdate = std::min(timeSinceLastUpdate, maxBacklog);
+
+		// at least one tick per frame; past the budget the backlog is dropped,
+		// the game runs slower instead of every frame falling further behind
+		sf::Clock tickClock;
+		size_t ticks = 0;
+		while (isRunning() && (_simulationSpeed == 0 || timeSinceLastUpdate > TimePerFrame))
 		{
-			currentScene()->update(SPF);			
-			timeSinceLastUpdate -= SPF;
+			if (ticks > 0 && tickClock.getElapsedTime() >= _tickBudget) {
+				timeSinceLastUpdate = sf::Time::Zero;
+				break;
+			}
+
+			currentScene()->beginTick();
+			sTickInput();
+			currentScene()->update(TimePerFrame);
+			timeSinceLastUpdate -= TimePerFrame;
+			++ticks;
+			++_statisticsNumTicks;
 		}
 
-		window().clear(sf::Color(34, 139, 34)); 
-		currentScene()->sRender();					
-		window().display();
+		// unlimited speed has no leftover time, it shows the latest tick
+		_renderAlpha = _simulationSpeed == 0 ? 1.f
+			: std::clamp(timeSinceLastUpdate.asSeconds() / TimePerFrame.asSeconds(), 0.f, 1.f);
+
+		if (++frame % _renderInterval == 0) {
+			window().clear(sf::Color(34, 139, 34));
+			currentScene()->sRender();
+			window().display();
+			++_statisticsNumFrames;
+		}
+
+		_statisticsUpdateTime += elapsed;
+		if (_statisticsUpdateTime >= sf::seconds(1.0f)) {
+			_frameRate = _statisticsNumFrames;
+			_tickRate = _statisticsNumTicks;
+			_statisticsNumFrames = 0;
+			_statisticsNumTicks = 0;
+			_statisticsUpdateTime -= sf::seconds(1.0f);
+		}
+
+		// the window's own limit only sleeps in display(), which frames skipped
+		// by the render interval never reach, so frames are paced here instead
+		if (_simulationSpeed == 1 && _frameRateLimit > 0) {
+			sf::Time wait = sf::seconds(1.f / _frameRateLimit) - frameClock.getElapsedTime();
+			if (wait > sf::Time::Zero)
+				sf::sleep(wait);
+		}
+		frameClock.restart();
 	}
+
+	if (_recorder)
+		_recorder->finish();
+}
+
+
+std::uint64_t GameEngine::simulate(std::uint64_t maxTicks, bool untilEnded)
+{
+	std::uint64_t ticks = 0;
+	while (isRunning() && ticks < maxTicks && !(untilEnded && currentScene()->hasEnded()))
+	{
+		Assets::getInstance().update();
+
+		currentScene()->beginTick();
+		sTickInput();
+		currentScene()->update(TimePerFrame);
+		++ticks;
+	}
+	return ticks;
 }
 
 
@@ -189,15 +406,26 @@ void GameEngine::backLevel()
 
 sf::RenderWindow& GameEngine::window()
 {
-	return _window;
+	return *_window;
 }
 
+// Fixed at the configured size so that a resized window can't change the
+// simulation; the window stretches its default view over whatever size it has.
 sf::Vector2f GameEngine::windowSize() const {
-	return sf::Vector2f{ _window.getSize() };
+	return _viewportSize;
+}
+
+const sf::View& GameEngine::view() const {
+	return _view;
+}
+
+void GameEngine::setViewport(sf::Vector2f size) {
+	_viewportSize = size;
+	_view.reset(sf::FloatRect(0.f, 0.f, size.x, size.y));
 }
 
 
 bool GameEngine::isRunning()
 {
-	return (_running && _window.isOpen());
+	return (_running && (_headless || _window->isOpen()));
 }
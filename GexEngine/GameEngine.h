@@ -1,6 +1,11 @@
 #pragma once
 
 #include "Assets.h"
+#include "ConfigWatcher.h"
+#include "InputSource.h"
+#include "InputJournal.h"
+#include "Random.h"
+#include <cstdint>
 #include <memory>
 #include <map>
 #include <SFML/Graphics.hpp>
@@ -13,24 +18,46 @@ using SceneMap = std::map<std::string, std::shared_ptr<Scene>>;
 class GameEngine
 {
 private:
-    sf::RenderWindow            _window;
+    std::unique_ptr<sf::RenderWindow> _window;             // null in headless runs
     std::string                 _currentScene;
     SceneMap                    _sceneMap;
-    size_t                      _simulationSpeed{ 1 };
+    size_t                      _simulationSpeed{ 1 };      // ticks per 1/60 s of real time, 0 for unlimited
+    size_t                      _renderInterval{ 1 };       // render every n-th frame
+    sf::Time                    _tickBudget;                // real time a frame may spend ticking
+    size_t                      _maxCatchUpTicks{ 5 };      // per unit of speed, after a hitch
+    float                       _renderAlpha{ 1.f };
+    unsigned int                _frameRateLimit{ 60 };
     bool                        _running{ true };
     sf::Time                    _frameTime;  
+    std::string                 _configPath;
+    ConfigWatcher               _configWatcher;
+    RandomService               _random;
+
+    // what the scenes simulate in, the window only scales it for drawing
+    bool                        _headless{ false };
+    sf::Vector2f                _viewportSize;
+    sf::View                    _view;
+
+    // replaces the keyboard when set
+    std::unique_ptr<InputSource>        _input;
+    std::vector<InputSource::KeyEvent>  _inputEvents;
+    JournalRecorder*                    _recorder{ nullptr };   // owned through _input
 
     // stats
     sf::Text                    _statisticsText;
     sf::Time                    _statisticsUpdateTime{ sf::Time::Zero };
     unsigned int                _statisticsNumFrames{ 0 };
+    unsigned int                _statisticsNumTicks{ 0 };
+    unsigned int                _frameRate{ 0 };
+    unsigned int                _tickRate{ 0 };
 
 public:
-    GameEngine(const std::string& path);
+    GameEngine(const std::string& path, bool headless = false);
 
     void                    init(const std::string& path);
     void                    update();
     void                    sUserInput();
+    void                    sTickInput();
     std::shared_ptr<Scene>  currentScene();
 
     void                    changeScene(const std::string& sceneName,
@@ -41,10 +68,52 @@ public:
     void                    quitLevel();
     void                    backLevel();
 
-    sf::RenderWindow& window();
+    // steps the current scene at the fixed rate as fast as it goes, without
+    // rendering, until the scene ends, the engine quits or maxTicks have run
+    std::uint64_t           simulate(std::uint64_t maxTicks, bool untilEnded = true);
+
+    // Turbo for soak tests and training runs: speed n runs n ticks per 1/60 s
+    // of real time, 0 as many as the tick budget allows. The frame rate limit
+    // only applies at speed 1, to every frame whether it is rendered or not.
+    void                    setSimulationSpeed(size_t speed);
+    size_t                  getSimulationSpeed() const;
+    void                    setRenderInterval(size_t interval);
+
+    // how far rendering is between the previous tick and the last one, 0..1;
+    // scenes draw moving things at previous + alpha * (current - previous)
+    float                   getRenderAlpha() const;
+
+    // measured over the last real second
+    unsigned int            getFrameRate() const;
+    unsigned int            getTickRate() const;
+
+    void                    setInputSource(std::unique_ptr<InputSource> input);
+    InputSource*            inputSource();
+    bool                    isKeyPressed(sf::Keyboard::Key key) const;
+    bool                    isHeadless() const;
+
+    // journals every Scene_Game session played from here on, see JournalRecorder;
+    // needs the window for its focus, so headless runs can't record
+    void                    startRecording(const std::string& path);
+
+    // called by a scene whose play should be reproducible from its seed and input
+    void                    beginSession(std::uint64_t seed);
+
+    // scenes take their Rng streams from here when they start
+    RandomService&          random();
+
+    sf::RenderWindow&       window();                       // not in headless runs
+
+    // the viewport, not the live window: the simulation must not depend on how
+    // big the window happens to be; replays set the one they were recorded in
     sf::Vector2f            windowSize() const;
+    const sf::View&         view() const;
+    void                    setViewport(sf::Vector2f size);
     bool                    isRunning();
 
     void                    loadConfigFromFile(const std::string& path,
         unsigned int& width, unsigned int& height) const;
+
+private:
+    void                    dispatchKey(sf::Keyboard::Key key, bool pressed);
 };
@@ -0,0 +1,221 @@
+#include "InputJournal.h"
+#include <SFML/Window/Window.hpp>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    template<typename T>
+    void writePod(std::ofstream& out, T value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    bool readPod(std::ifstream& in, T& value) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    int bitOf(sf::Keyboard::Key key) {
+        const auto& keys = InputJournal::keys();
+        auto found = std::find(keys.begin(), keys.end(), key);
+        return found == keys.end() ? -1 : static_cast<int>(found - keys.begin());
+    }
+}
+
+
+// every key a scene maps, new ones go at the end so old journals still read
+const std::vector<sf::Keyboard::Key>& InputJournal::keys() {
+    static const std::vector<sf::Keyboard::Key> keys = {
+        sf::Keyboard::W, sf::Keyboard::A, sf::Keyboard::S, sf::Keyboard::D,
+        sf::Keyboard::Up, sf::Keyboard::Down, sf::Keyboard::Left, sf::Keyboard::Right,
+        sf::Keyboard::Enter, sf::Keyboard::Escape, sf::Keyboard::Space,
+        sf::Keyboard::R, sf::Keyboard::F1,
+    };
+    return keys;
+}
+
+
+std::uint32_t InputJournal::sampleKeyboard() {
+    std::uint32_t mask = 0;
+    const auto& tracked = keys();
+    for (size_t i = 0; i < tracked.size(); ++i) {
+        if (sf::Keyboard::isKeyPressed(tracked[i]))
+            mask |= 1u << i;
+    }
+    return mask;
+}
+
+
+void InputJournal::diff(std::uint32_t previous, std::uint32_t current, std::vector<InputSource::KeyEvent>& events) {
+    std::uint32_t changed = previous ^ current;
+    const auto& tracked = keys();
+    for (size_t i = 0; changed != 0 && i < tracked.size(); ++i) {
+        if (changed & (1u << i))
+            events.push_back(InputSource::KeyEvent{ tracked[i], (current & (1u << i)) != 0 });
+        changed &= ~(1u << i);
+    }
+}
+
+
+void InputJournal::clear(std::uint64_t seed, sf::Vector2u viewport) {
+    m_seed = seed;
+    m_viewport = viewport;
+    m_tickCount = 0;
+    m_runs.clear();
+}
+
+
+void InputJournal::append(std::uint32_t mask) {
+    if (!m_runs.empty() && m_runs.back().mask == mask && m_runs.back().length < UINT32_MAX)
+        ++m_runs.back().length;
+    else
+        m_runs.push_back(Run{ mask, 1 });
+    ++m_tickCount;
+}
+
+
+bool InputJournal::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Failed to write input journal " << path << "\n";
+        return false;
+    }
+
+    out.write(InputJournalFormat::Magic, sizeof(InputJournalFormat::Magic));
+    writePod(out, InputJournalFormat::Version);
+    writePod(out, m_seed);
+    writePod(out, static_cast<std::uint32_t>(m_viewport.x));
+    writePod(out, static_cast<std::uint32_t>(m_viewport.y));
+    writePod(out, m_tickCount);
+    writePod(out, static_cast<std::uint32_t>(m_runs.size()));
+    for (const auto& run : m_runs) {
+        writePod(out, run.mask);
+        writePod(out, run.length);
+    }
+    return static_cast<bool>(out);
+}
+
+
+bool InputJournal::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Open file " << path << " failed\n";
+        return false;
+    }
+
+    char magic[sizeof(InputJournalFormat::Magic)];
+    std::uint32_t version, runCount, width = 0, height = 0;
+    std::uint64_t seed, tickCount;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, InputJournalFormat::Magic, sizeof(magic)) != 0
+        || !readPod(in, version) || version < 1 || version > InputJournalFormat::Version
+        || !readPod(in, seed) || (version >= 2 && (!readPod(in, width) || !readPod(in, height)))
+        || !readPod(in, tickCount) || !readPod(in, runCount)) {
+        std::cerr << "Input journal " << path << " is damaged or from another version\n";
+        return false;
+    }
+
+    clear(seed, sf::Vector2u(width, height));
+    m_runs.reserve(runCount);
+    for (std::uint32_t i = 0; i < runCount; ++i) {
+        Run run;
+        if (!readPod(in, run.mask) || !readPod(in, run.length) || run.length == 0) {
+            std::cerr << "Input journal " << path << " is truncated\n";
+            clear(0);
+            return false;
+        }
+        m_runs.push_back(run);
+        m_tickCount += run.length;
+    }
+
+    if (m_tickCount != tickCount) {
+        std::cerr << "Input journal " << path << " is damaged or from another version\n";
+        clear(0);
+        return false;
+    }
+    return true;
+}
+
+
+std::string JournalRecorder::sessionPath() const {
+    if (m_sessions <= 1)
+        return m_path;
+
+    std::filesystem::path path(m_path);
+    path.replace_filename(path.stem().string() + "-" + std::to_string(m_sessions) + path.extension().string());
+    return path.string();
+}
+
+
+// the scene starting the session updates on the tick that was just polled,
+// so the journal opens with that tick's keys
+void JournalRecorder::begin(std::uint64_t seed, sf::Vector2u viewport) {
+    finish();
+    ++m_sessions;
+    m_journal.clear(seed, viewport);
+    m_journal.append(m_mask);
+    m_recording = true;
+}
+
+
+void JournalRecorder::finish() {
+    if (!m_recording)
+        return;
+
+    m_recording = false;
+    if (m_journal.save(sessionPath()))
+        std::cout << "Recorded " << m_journal.getTickCount() << " ticks to " << sessionPath() << std::endl;
+}
+
+
+void JournalRecorder::poll(std::vector<KeyEvent>& events) {
+    // losing focus releases everything that was held
+    std::uint32_t mask = m_window.hasFocus() ? InputJournal::sampleKeyboard() : 0;
+    InputJournal::diff(m_mask, mask, events);
+    m_mask = mask;
+
+    if (m_recording)
+        m_journal.append(m_mask);
+}
+
+
+bool JournalRecorder::isKeyPressed(sf::Keyboard::Key key) const {
+    int bit = bitOf(key);
+    return bit >= 0 && (m_mask & (1u << bit)) != 0;
+}
+
+
+JournalPlayer::JournalPlayer(const InputJournal& journal)
+    : m_journal(journal) {
+    rewind();
+}
+
+
+void JournalPlayer::rewind() {
+    m_run = 0;
+    m_used = 0;
+    m_mask = m_journal.getRuns().empty() ? 0 : m_journal.getRuns().front().mask;
+}
+
+
+void JournalPlayer::poll(std::vector<KeyEvent>& events) {
+    const auto& runs = m_journal.getRuns();
+    std::uint32_t mask = 0;
+    if (m_run < runs.size()) {
+        mask = runs[m_run].mask;
+        if (++m_used == runs[m_run].length) {
+            ++m_run;
+            m_used = 0;
+        }
+    }
+
+    InputJournal::diff(m_mask, mask, events);
+    m_mask = mask;
+}
+
+
+bool JournalPlayer::isKeyPressed(sf::Keyboard::Key key) const {
+    int bit = bitOf(key);
+    return bit >= 0 && (m_mask & (1u << bit)) != 0;
+}
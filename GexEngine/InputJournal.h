@@ -0,0 +1,105 @@
+#pragma once
+#include "InputSource.h"
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sf { class Window; }
+
+// Binary journal of one Scene_Game session: the seed its Rng streams came from,
+// the viewport it was simulated in and the state of the tracked keys on every
+// simulation tick. Layout, all little endian:
+//
+//   header   "GEXJRNL\0", u32 version, u64 seed, u32 viewport width,
+//            u32 viewport height, u64 tick count, u32 run count
+//   runs     u32 key mask, u32 ticks it was held
+//
+// Held keys repeat the same mask for many ticks, so runs keep a session of a
+// few minutes down to a few kilobytes. Version 1 had no viewport, those
+// journals load with a 0x0 one and replay in the configured size.
+namespace InputJournalFormat {
+    constexpr char          Magic[8]    = { 'G', 'E', 'X', 'J', 'R', 'N', 'L', '\0' };
+    constexpr std::uint32_t Version     = 2;
+}
+
+
+class InputJournal {
+public:
+    struct Run {
+        std::uint32_t   mask;
+        std::uint32_t   length;
+    };
+
+    // bit i of a mask is keys()[i]
+    static const std::vector<sf::Keyboard::Key>& keys();
+    static std::uint32_t sampleKeyboard();
+
+    // key events that turn the previous mask into the current one
+    static void diff(std::uint32_t previous, std::uint32_t current, std::vector<InputSource::KeyEvent>& events);
+
+private:
+    std::uint64_t       m_seed{ 0 };
+    sf::Vector2u        m_viewport;
+    std::uint64_t       m_tickCount{ 0 };
+    std::vector<Run>    m_runs;
+
+public:
+    void clear(std::uint64_t seed, sf::Vector2u viewport = sf::Vector2u());
+    void append(std::uint32_t mask);
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    std::uint64_t getSeed() const { return m_seed; }
+    sf::Vector2u getViewport() const { return m_viewport; }
+    std::uint64_t getTickCount() const { return m_tickCount; }
+    const std::vector<Run>& getRuns() const { return m_runs; }
+};
+
+
+// Reads the real keyboard once per tick, and only while the window has focus,
+// so keys typed into other applications neither move the game nor land in the
+// journal. Between begin() and the next begin() or finish() every tick is
+// journalled; each session goes to its own file, path for the first and
+// path-2, path-3, ... for the ones after it.
+class JournalRecorder : public InputSource {
+private:
+    const sf::Window& m_window;
+    InputJournal    m_journal;
+    std::string     m_path;
+    std::uint32_t   m_mask{ 0 };
+    int             m_sessions{ 0 };
+    bool            m_recording{ false };
+
+    std::string sessionPath() const;
+
+public:
+    JournalRecorder(const std::string& path, const sf::Window& window) : m_window(window), m_path(path) {}
+
+    void begin(std::uint64_t seed, sf::Vector2u viewport);
+    void finish();
+
+    void poll(std::vector<KeyEvent>& events) override;
+    bool isKeyPressed(sf::Keyboard::Key key) const override;
+};
+
+
+// Feeds a journal back tick by tick; every key is up once it runs out.
+class JournalPlayer : public InputSource {
+private:
+    const InputJournal& m_journal;
+    size_t              m_run{ 0 };
+    std::uint32_t       m_used{ 0 };        // ticks taken from the current run
+    std::uint32_t       m_mask{ 0 };
+
+public:
+    explicit JournalPlayer(const InputJournal& journal);
+
+    // the keys held on the first tick start out held, the session saw no presses for them
+    void rewind();
+    bool isFinished() const { return m_run >= m_journal.getRuns().size(); }
+
+    void poll(std::vector<KeyEvent>& events) override;
+    bool isKeyPressed(sf::Keyboard::Key key) const override;
+};
@@ -0,0 +1,116 @@
+#include "InputSource.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    struct NamedKey {
+        const char*         name;
+        sf::Keyboard::Key   key;
+    };
+
+    const NamedKey NamedKeys[] = {
+        { "Up", sf::Keyboard::Up },         { "Down", sf::Keyboard::Down },
+        { "Left", sf::Keyboard::Left },     { "Right", sf::Keyboard::Right },
+        { "Enter", sf::Keyboard::Enter },   { "Escape", sf::Keyboard::Escape },
+        { "Space", sf::Keyboard::Space },
+    };
+}
+
+
+bool ScriptedInput::loadFromFile(const std::string& path) {
+    std::ifstream script(path);
+    if (script.fail()) {
+        std::cerr << "Open file " << path << " failed\n";
+        return false;
+    }
+
+    m_steps.clear();
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(script, line)) {
+        ++lineNumber;
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream iss(line);
+        std::uint64_t tick;
+        std::string action, keyName;
+        iss >> tick >> action >> keyName;
+
+        auto key = keyFromName(keyName);
+        if (iss.fail() || (action != "press" && action != "release") || key == sf::Keyboard::Unknown) {
+            std::cerr << path << ":" << lineNumber << ": expected '<tick> press|release <key>'\n";
+            return false;
+        }
+        addStep(tick, key, action == "press");
+    }
+
+    rewind();
+    return true;
+}
+
+
+void ScriptedInput::addStep(std::uint64_t tick, sf::Keyboard::Key key, bool pressed) {
+    // stable, so steps on the same tick keep their order
+    auto at = std::upper_bound(m_steps.begin(), m_steps.end(), tick,
+        [](std::uint64_t t, const Step& step) { return t < step.tick; });
+    m_steps.insert(at, Step{ tick, key, pressed });
+}
+
+
+void ScriptedInput::rewind() {
+    m_next = 0;
+    m_tick = 0;
+    m_down.fill(false);
+}
+
+
+void ScriptedInput::poll(std::vector<KeyEvent>& events) {
+    while (m_next < m_steps.size() && m_steps[m_next].tick <= m_tick) {
+        const Step& step = m_steps[m_next++];
+        m_down[step.key] = step.pressed;
+        events.push_back(KeyEvent{ step.key, step.pressed });
+    }
+    ++m_tick;
+}
+
+
+bool ScriptedInput::isKeyPressed(sf::Keyboard::Key key) const {
+    return key >= 0 && key < sf::Keyboard::KeyCount && m_down[key];
+}
+
+
+sf::Keyboard::Key ScriptedInput::keyFromName(const std::string& name) {
+    if (name.size() == 1 && name[0] >= 'A' && name[0] <= 'Z')
+        return static_cast<sf::Keyboard::Key>(sf::Keyboard::A + (name[0] - 'A'));
+    if (name.size() == 1 && name[0] >= '0' && name[0] <= '9')
+        return static_cast<sf::Keyboard::Key>(sf::Keyboard::Num0 + (name[0] - '0'));
+    if (name.size() >= 2 && name[0] == 'F') {
+        int number = std::atoi(name.c_str() + 1);
+        if (number >= 1 && number <= 12)
+            return static_cast<sf::Keyboard::Key>(sf::Keyboard::F1 + (number - 1));
+    }
+    for (const auto& named : NamedKeys) {
+        if (name == named.name)
+            return named.key;
+    }
+    return sf::Keyboard::Unknown;
+}
+
+
+std::string ScriptedInput::keyName(sf::Keyboard::Key key) {
+    if (key >= sf::Keyboard::A && key <= sf::Keyboard::Z)
+        return std::string(1, static_cast<char>('A' + (key - sf::Keyboard::A)));
+    if (key >= sf::Keyboard::Num0 && key <= sf::Keyboard::Num9)
+        return std::string(1, static_cast<char>('0' + (key - sf::Keyboard::Num0)));
+    if (key >= sf::Keyboard::F1 && key <= sf::Keyboard::F12)
+        return "F" + std::to_string(key - sf::Keyboard::F1 + 1);
+    for (const auto& named : NamedKeys) {
+        if (key == named.key)
+            return named.name;
+    }
+    return "Unknown";
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <SFML/Window/Keyboard.hpp>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Where key state comes from when it isn't the real keyboard. GameEngine
+// polls it once per simulation tick and scenes ask it through isKeyPressed.
+class InputSource {
+public:
+    struct KeyEvent {
+        sf::Keyboard::Key   key;
+        bool                pressed;
+    };
+
+    virtual ~InputSource() = default;
+
+    // advances one tick, appending the presses and releases that happen on it
+    virtual void poll(std::vector<KeyEvent>& events) = 0;
+    virtual bool isKeyPressed(sf::Keyboard::Key key) const = 0;
+};
+
+
+// Fixed timeline of key presses and releases, one per line:
+//
+//   <tick> press|release <key>      e.g.   0 press W
+//                                         90 release W
+//
+// Keys are letters, digits, arrows (Up, Down, Left, Right), Enter, Escape,
+// Space and F1..F12. Lines starting with # are comments.
+class ScriptedInput : public InputSource {
+private:
+    struct Step {
+        std::uint64_t       tick;
+        sf::Keyboard::Key   key;
+        bool                pressed;
+    };
+
+    std::vector<Step>                           m_steps;        // sorted by tick
+    size_t                                      m_next{ 0 };
+    std::uint64_t                               m_tick{ 0 };
+    std::array<bool, sf::Keyboard::KeyCount>    m_down{};
+
+public:
+    bool loadFromFile(const std::string& path);
+    void addStep(std::uint64_t tick, sf::Keyboard::Key key, bool pressed);
+
+    // back to tick 0 with every key up, for running the same script again
+    void rewind();
+
+    void poll(std::vector<KeyEvent>& events) override;
+    bool isKeyPressed(sf::Keyboard::Key key) const override;
+
+    static sf::Keyboard::Key keyFromName(const std::string& name);
+    static std::string keyName(sf::Keyboard::Key key);
+};
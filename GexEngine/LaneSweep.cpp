@@ -0,0 +1,110 @@
+#include "LaneSweep.h"
+#include <algorithm>
+#include <cmath>
+
+LaneSweep::LaneSweep(int laneCount)
+    : m_lanes(static_cast<size_t>(std::max(1, laneCount))) {
+}
+
+size_t LaneSweep::lowerBound(const Lane& lane, float top) {
+    auto it = std::lower_bound(lane.entries.begin(), lane.entries.end(), top,
+        [](const Entry& e, float value) { return e.bounds.top < value; });
+    return static_cast<size_t>(it - lane.entries.begin());
+}
+
+void LaneSweep::resort(Lane& lane) {
+    auto& entries = lane.entries;
+    for (size_t i = 1; i < entries.size(); ++i) {
+        Entry moving = entries[i];
+        size_t j = i;
+        while (j > 0 && entries[j - 1].bounds.top > moving.bounds.top) {
+            entries[j] = entries[j - 1];
+            --j;
+        }
+        entries[j] = moving;
+    }
+}
+
+void LaneSweep::recomputeExtents(Lane& lane) {
+    lane.maxHeight = 0.f;
+    lane.left = 0.f;
+    lane.right = 0.f;
+    if (lane.entries.empty())
+        return;
+
+    lane.left = lane.entries.front().bounds.left;
+    lane.right = lane.left;
+    for (const auto& e : lane.entries) {
+        lane.maxHeight = std::max(lane.maxHeight, e.bounds.height);
+        lane.left = std::min(lane.left, e.bounds.left);
+        lane.right = std::max(lane.right, e.bounds.left + e.bounds.width);
+    }
+}
+
+void LaneSweep::rebuildBoxes(const Lane& lane) {
+    lane.boxes.clear();
+    for (const auto& e : lane.entries)
+        lane.boxes.push(e.bounds);
+    lane.boxesDirty = false;
+}
+
+const AabbBatch& LaneSweep::boxesOf(const Lane& lane) {
+    if (lane.boxesDirty)
+        rebuildBoxes(lane);
+    return lane.boxes;
+}
+
+void LaneSweep::insert(int lane, EntityId id, const sf::FloatRect& bounds, const sf::Vector2f& position) {
+    auto& l = m_lanes[std::clamp(lane, 0, static_cast<int>(m_lanes.size()) - 1)];
+
+    if (l.entries.empty()) {
+        l.left = bounds.left;
+        l.right = bounds.left + bounds.width;
+    }
+    l.maxHeight = std::max(l.maxHeight, bounds.height);
+    l.left = std::min(l.left, bounds.left);
+    l.right = std::max(l.right, bounds.left + bounds.width);
+
+    auto it = std::upper_bound(l.entries.begin(), l.entries.end(), bounds.top,
+        [](float value, const Entry& e) { return value < e.bounds.top; });
+    l.entries.insert(it, Entry{ id, bounds, position });
+    l.boxesDirty = true;
+}
+
+void LaneSweep::clear() {
+    for (auto& lane : m_lanes) {
+        lane.entries.clear();
+        lane.boxes.clear();
+        lane.boxesDirty = false;
+        recomputeExtents(lane);
+    }
+}
+
+void LaneSweep::query(const sf::FloatRect& area, std::vector<EntityId>& hits) const {
+    float right = area.left + area.width;
+    float bottom = area.top + area.height;
+
+    for (const auto& lane : m_lanes) {
+        if (lane.entries.empty() || right <= lane.left || area.left >= lane.right)
+            continue;
+
+        size_t first = lowerBound(lane, area.top - lane.maxHeight);
+        size_t last = lowerBound(lane, bottom);
+        boxesOf(lane).forEachOverlap(area, first, last, [&](size_t i) {
+            hits.push_back(lane.entries[i].id);
+            });
+    }
+}
+
+bool LaneSweep::anyNear(const sf::Vector2f& position, float minDistance) const {
+    for (const auto& lane : m_lanes) {
+        // position sits inside its bounds, so top is within maxHeight above it
+        for (size_t i = lowerBound(lane, position.y - minDistance - lane.maxHeight);
+            i < lane.entries.size() && lane.entries[i].bounds.top < position.y + minDistance; ++i) {
+            sf::Vector2f d = lane.entries[i].position - position;
+            if (std::sqrt(d.x * d.x + d.y * d.y) < minDistance)
+                return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "Entity.h"
+#include "AabbBatch.h"
+
+// Sweep-and-prune specialised for the road. Objects never leave the lane they
+// spawned in and only move vertically, so each lane keeps its entries sorted
+// by top edge. Overlap tests become a walk along sorted lists, and the order
+// is repaired with an insertion sort that is linear when little changed.
+// Each lane mirrors its sorted bounds into an AabbBatch for the overlap tests.
+class LaneSweep {
+public:
+    struct Entry {
+        EntityId        id;
+        sf::FloatRect   bounds;
+        sf::Vector2f    position;   // must lie inside bounds
+    };
+
+private:
+    struct Lane {
+        std::vector<Entry>  entries;
+        // rebuilt from entries on first use after they change, so a burst of
+        // inserts costs one rebuild
+        mutable AabbBatch   boxes;
+        mutable bool        boxesDirty{ false };
+        float               maxHeight{ 0.f };
+        float               left{ 0.f };
+        float               right{ 0.f };
+    };
+
+    std::vector<Lane> m_lanes;
+
+    static size_t lowerBound(const Lane& lane, float top);
+    static void resort(Lane& lane);
+    static void recomputeExtents(Lane& lane);
+    static void rebuildBoxes(const Lane& lane);
+    static const AabbBatch& boxesOf(const Lane& lane);
+
+public:
+    explicit LaneSweep(int laneCount);
+
+    void insert(int lane, EntityId id, const sf::FloatRect& bounds, const sf::Vector2f& position);
+    void clear();
+
+    // fetch(id, entry) refreshes entry.bounds/position and returns false to drop it
+    template<typename F>
+    void refresh(F&& fetch) {
+        for (auto& lane : m_lanes) {
+            auto& entries = lane.entries;
+            size_t kept = 0;
+            for (size_t i = 0; i < entries.size(); ++i) {
+                if (fetch(entries[i].id, entries[i]))
+                    entries[kept++] = entries[i];
+            }
+            entries.resize(kept);
+            resort(lane);
+            recomputeExtents(lane);
+            lane.boxesDirty = true;
+        }
+    }
+
+    // appends the ids whose bounds intersect area
+    void query(const sf::FloatRect& area, std::vector<EntityId>& hits) const;
+
+    // true if any entry's position is closer than minDistance to position
+    bool anyNear(const sf::Vector2f& position, float minDistance) const;
+
+    // calls onPair(ourId, theirId) for every intersecting pair sharing a lane
+    template<typename F>
+    void forEachOverlap(const LaneSweep& other, F&& onPair) const {
+        size_t laneCount = std::min(m_lanes.size(), other.m_lanes.size());
+        for (size_t l = 0; l < laneCount; ++l) {
+            const auto& ours = m_lanes[l].entries;
+            const auto& theirs = other.m_lanes[l].entries;
+            const auto& theirBoxes = boxesOf(other.m_lanes[l]);
+            float theirMaxHeight = other.m_lanes[l].maxHeight;
+
+            size_t start = 0;
+            size_t end = 0;
+            for (const auto& a : ours) {
+                // entries ending above a can't reach any later a either
+                while (start < theirs.size() && theirs[start].bounds.top + theirMaxHeight <= a.bounds.top)
+                    ++start;
+
+                float bottom = a.bounds.top + a.bounds.height;
+                end = std::max(end, start);
+                while (end < theirs.size() && theirs[end].bounds.top < bottom)
+                    ++end;
+
+                theirBoxes.forEachOverlap(a.bounds, start, end, [&](size_t j) {
+                    onPair(a.id, theirs[j].id);
+                    });
+            }
+        }
+    }
+};
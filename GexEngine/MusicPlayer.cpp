@@ -17,26 +17,41 @@ MusicPlayer& MusicPlayer::getInstance() {
 }
 
 void MusicPlayer::play(String theme) {
-    if (!m_music.openFromFile(m_filenames[theme]))
+    if (!m_enabled)
+        return;
+
+    if (!m_music)
+        m_music = std::make_unique<sf::Music>();
+    if (!m_music->openFromFile(m_filenames[theme]))
         throw std::runtime_error("Music could not open file");
 
-    m_music.setVolume(m_volume);
-    m_music.setLoop(true);
-    m_music.play();
+    m_music->setVolume(m_volume);
+    m_music->setLoop(true);
+    m_music->play();
 }
 
 void MusicPlayer::stop() {
-    m_music.stop();
+    if (m_music)
+        m_music->stop();
 }
 
 void MusicPlayer::setPaused(bool paused) {
+    if (!m_music)
+        return;
     if (paused)
-        m_music.pause();
+        m_music->pause();
     else
-        m_music.play();
+        m_music->play();
 }
 
 void MusicPlayer::setVolume(float volume) {
     m_volume = volume;
-    m_music.setVolume(m_volume);
+    if (m_music)
+        m_music->setVolume(m_volume);
+}
+
+void MusicPlayer::setEnabled(bool enabled) {
+    m_enabled = enabled;
+    if (!m_enabled)
+        stop();
 }
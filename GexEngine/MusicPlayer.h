@@ -1,6 +1,7 @@
 #pragma once
 #include <SFML/Audio.hpp>
 #include <map>
+#include <memory>
 #include <string>
 
 using String = std::string;
@@ -8,8 +9,9 @@ using String = std::string;
 class MusicPlayer {
 private:
     std::map<String, String> m_filenames;
-    sf::Music m_music;
+    std::unique_ptr<sf::Music> m_music;   // opens the audio device, so made on first play
     float m_volume = 100.f;
+    bool m_enabled = true;
 
     MusicPlayer();
 
@@ -24,4 +26,5 @@ public:
     void stop();
     void setPaused(bool paused);
     void setVolume(float volume);
+    void setEnabled(bool enabled);
 };
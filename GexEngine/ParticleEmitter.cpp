@@ -0,0 +1,137 @@
+#include "ParticleEmitter.h"
+#include <algorithm>
+#include <cmath>
+
+ParticleEmitter::ParticleEmitter(size_t capacity) {
+    setCapacity(capacity);
+}
+
+void ParticleEmitter::setCapacity(size_t capacity) {
+    m_capacity = capacity;
+    m_count = 0;
+
+    for (auto* values : { &m_posX, &m_posY, &m_velX, &m_velY, &m_life, &m_invLifetime, &m_size, &m_phase })
+        values->assign(capacity, 0.f);
+    m_color.assign(capacity, sf::Color::White);
+
+    m_vertices.clear();
+    m_verticesDirty = true;
+}
+
+void ParticleEmitter::setFade(float fraction) {
+    m_fadeFraction = std::clamp(fraction, 0.001f, 1.f);
+}
+
+void ParticleEmitter::setWobble(float amplitude, float frequency) {
+    m_wobbleAmplitude = amplitude;
+    m_wobbleFrequency = frequency;
+}
+
+bool ParticleEmitter::emit(const sf::Vector2f& position, const sf::Vector2f& velocity,
+    float size, const sf::Color& color, float lifetime) {
+    if (m_count == m_capacity || lifetime <= 0.f)
+        return false;
+
+    size_t i = m_count++;
+    m_posX[i] = position.x;
+    m_posY[i] = position.y;
+    m_velX[i] = velocity.x;
+    m_velY[i] = velocity.y;
+    m_life[i] = lifetime;
+    m_invLifetime[i] = 1.f / lifetime;
+    m_size[i] = size;
+    m_phase[i] = static_cast<float>(i);
+    m_color[i] = color;
+
+    m_verticesDirty = true;
+    return true;
+}
+
+void ParticleEmitter::update(float dt) {
+    m_time += dt;
+
+    float dvx = m_acceleration.x * dt;
+    float dvy = m_acceleration.y * dt;
+    for (size_t i = 0; i < m_count; ++i) {
+        m_velX[i] += dvx;
+        m_velY[i] += dvy;
+    }
+
+    for (size_t i = 0; i < m_count; ++i) {
+        m_posX[i] += m_velX[i] * dt;
+        m_posY[i] += m_velY[i] * dt;
+        m_life[i] -= dt;
+    }
+
+    if (m_wobbleAmplitude != 0.f) {
+        float drift = m_wobbleAmplitude * dt;
+        for (size_t i = 0; i < m_count; ++i)
+            m_posX[i] += drift * std::sin(m_time * m_wobbleFrequency + m_phase[i]);
+    }
+
+    for (size_t i = m_count; i-- > 0;) {
+        if (m_life[i] <= 0.f)
+            kill(i);
+    }
+
+    m_verticesDirty = true;
+}
+
+void ParticleEmitter::clear() {
+    m_count = 0;
+    m_time = 0.f;
+    m_verticesDirty = true;
+}
+
+// swap-and-pop, order of the survivors doesn't matter
+void ParticleEmitter::kill(size_t i) {
+    size_t last = --m_count;
+    if (i == last)
+        return;
+
+    m_posX[i] = m_posX[last];
+    m_posY[i] = m_posY[last];
+    m_velX[i] = m_velX[last];
+    m_velY[i] = m_velY[last];
+    m_life[i] = m_life[last];
+    m_invLifetime[i] = m_invLifetime[last];
+    m_size[i] = m_size[last];
+    m_phase[i] = m_phase[last];
+    m_color[i] = m_color[last];
+}
+
+void ParticleEmitter::rebuildVertices() const {
+    m_vertices.resize(m_count * 6);
+
+    float invFade = 1.f / m_fadeFraction;
+    for (size_t i = 0; i < m_count; ++i) {
+        float half = m_size[i] * 0.5f;
+        float left = m_posX[i] - half;
+        float top = m_posY[i] - half;
+        float right = m_posX[i] + half;
+        float bottom = m_posY[i] + half;
+
+        float fade = std::min(1.f, m_life[i] * m_invLifetime[i] * invFade);
+        sf::Color color = m_color[i];
+        color.a = static_cast<sf::Uint8>(color.a * fade);
+
+        sf::Vertex* quad = &m_vertices[i * 6];
+        quad[0] = sf::Vertex(sf::Vector2f(left, top), color);
+        quad[1] = sf::Vertex(sf::Vector2f(right, top), color);
+        quad[2] = sf::Vertex(sf::Vector2f(right, bottom), color);
+        quad[3] = quad[0];
+        quad[4] = quad[2];
+        quad[5] = sf::Vertex(sf::Vector2f(left, bottom), color);
+    }
+
+    m_verticesDirty = false;
+}
+
+void ParticleEmitter::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (m_count == 0)
+        return;
+
+    if (m_verticesDirty)
+        rebuildVertices();
+    target.draw(m_vertices, states);
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Fixed-capacity particle pool. Each attribute lives in its own array so the
+// per-frame integration is a handful of straight loops over floats, dead
+// particles are swap-and-popped, and the whole pool is drawn as one vertex
+// array of quads.
+class ParticleEmitter : public sf::Drawable {
+private:
+    size_t                  m_capacity{ 0 };
+    size_t                  m_count{ 0 };
+
+    std::vector<float>      m_posX;         // centre
+    std::vector<float>      m_posY;
+    std::vector<float>      m_velX;
+    std::vector<float>      m_velY;
+    std::vector<float>      m_life;         // seconds left
+    std::vector<float>      m_invLifetime;
+    std::vector<float>      m_size;
+    std::vector<float>      m_phase;
+    std::vector<sf::Color>  m_color;
+
+    sf::Vector2f            m_acceleration{ 0.f, 0.f };
+    float                   m_fadeFraction{ 1.f };
+    float                   m_wobbleAmplitude{ 0.f };
+    float                   m_wobbleFrequency{ 0.f };
+    float                   m_time{ 0.f };
+
+    mutable sf::VertexArray m_vertices{ sf::Triangles };
+    mutable bool            m_verticesDirty{ true };
+
+    void kill(size_t i);
+    void rebuildVertices() const;
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+public:
+    explicit ParticleEmitter(size_t capacity = 0);
+
+    // drops every live particle
+    void setCapacity(size_t capacity);
+
+    void setAcceleration(const sf::Vector2f& acceleration) { m_acceleration = acceleration; }
+
+    // alpha stays put until this fraction of the lifetime is left, then falls to zero
+    void setFade(float fraction);
+
+    // sideways drift of amplitude px/s, each particle with its own phase
+    void setWobble(float amplitude, float frequency);
+
+    // false when the pool is full
+    bool emit(const sf::Vector2f& position, const sf::Vector2f& velocity,
+        float size, const sf::Color& color, float lifetime);
+
+    void update(float dt);
+    void clear();
+
+    size_t size() const { return m_count; }
+    size_t capacity() const { return m_capacity; }
+};
@@ -0,0 +1,83 @@
+#include "Random.h"
+#include <random>
+
+namespace {
+    // splitmix64, spreads a seed over the generator state
+    std::uint64_t splitMix(std::uint64_t& x) {
+        std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // FNV-1a, stable across compilers unlike std::hash
+    std::uint64_t hashName(std::string_view name) {
+        std::uint64_t hash = 0xCBF29CE484222325ull;
+        for (char c : name) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 0x100000001B3ull;
+        }
+        return hash;
+    }
+}
+
+
+void Rng::reseed(std::uint64_t seed) {
+    std::uint64_t a = splitMix(seed);
+    std::uint64_t b = splitMix(seed);
+    m_state[0] = static_cast<std::uint32_t>(a);
+    m_state[1] = static_cast<std::uint32_t>(a >> 32);
+    m_state[2] = static_cast<std::uint32_t>(b);
+    m_state[3] = static_cast<std::uint32_t>(b >> 32);
+}
+
+
+// Lemire's multiply and reject, the retry is rare for small bounds
+std::uint32_t Rng::below(std::uint32_t bound) {
+    if (bound == 0)
+        return 0;
+
+    std::uint64_t m = static_cast<std::uint64_t>(next()) * bound;
+    auto low = static_cast<std::uint32_t>(m);
+    if (low < bound) {
+        std::uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold) {
+            m = static_cast<std::uint64_t>(next()) * bound;
+            low = static_cast<std::uint32_t>(m);
+        }
+    }
+    return static_cast<std::uint32_t>(m >> 32);
+}
+
+
+int Rng::range(int min, int max) {
+    if (max <= min)
+        return min;
+    auto span = static_cast<std::uint32_t>(static_cast<std::int64_t>(max) - min + 1);
+    return static_cast<int>(min + static_cast<std::int64_t>(span == 0 ? next() : below(span)));
+}
+
+
+void Rng::fill(float* out, size_t count, float min, float max) {
+    const float scale = (max - min) * (1.f / 16777216.f);
+    for (size_t i = 0; i < count; ++i)
+        out[i] = min + static_cast<float>(next() >> 8) * scale;
+}
+
+
+void Rng::fill(int* out, size_t count, int min, int max) {
+    for (size_t i = 0; i < count; ++i)
+        out[i] = range(min, max);
+}
+
+
+Rng RandomService::stream(std::string_view name) const {
+    std::uint64_t mixed = m_seed ^ hashName(name);
+    return Rng(splitMix(mixed));
+}
+
+
+std::uint64_t RandomService::randomSeed() {
+    std::random_device device;
+    return (static_cast<std::uint64_t>(device()) << 32) | device();
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// xoshiro128** generator: 16 bytes of state, a few cycles per number, and the
+// same sequence on every platform for a given seed. Each system owns its own
+// Rng, so nothing is shared between threads or between subsystems.
+class Rng {
+private:
+    std::uint32_t m_state[4];
+
+    static std::uint32_t rotl(std::uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+public:
+    explicit Rng(std::uint64_t seed = 0) { reseed(seed); }
+
+    void reseed(std::uint64_t seed);
+
+    std::uint32_t next() {
+        std::uint32_t result = rotl(m_state[1] * 5, 7) * 9;
+        std::uint32_t t = m_state[1] << 9;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotl(m_state[3], 11);
+        return result;
+    }
+
+    // [0, bound) without the modulo bias of rand() % bound
+    std::uint32_t below(std::uint32_t bound);
+
+    // [0, 1)
+    float unit() { return static_cast<float>(next() >> 8) * (1.f / 16777216.f); }
+
+    int range(int min, int max);                // [min, max]
+    float range(float min, float max) { return min + (max - min) * unit(); }
+
+    // batches for particle bursts and the like
+    void fill(float* out, size_t count, float min, float max);
+    void fill(int* out, size_t count, int min, int max);
+};
+
+
+// Derives named streams from one seed. The same seed and name always give the
+// same sequence, so a run can be replayed from its seed, and a stream only
+// depends on its own name, not on how much the others have been used.
+class RandomService {
+private:
+    std::uint64_t m_seed{ 0 };
+    std::uint64_t m_sessions{ 0 };
+
+public:
+    explicit RandomService(std::uint64_t seed = 0) : m_seed(seed) {}
+
+    void setSeed(std::uint64_t seed) { m_seed = seed; m_sessions = 0; }
+    std::uint64_t getSeed() const { return m_seed; }
+
+    // seed for the next play session: seed, seed + 1, ... counting from setSeed,
+    // so every game gets new spawns and a recorded one can be set up again
+    std::uint64_t nextSession() { return m_seed + m_sessions++; }
+
+    Rng stream(std::string_view name) const;
+
+    // fresh entropy, for when no seed was asked for
+    static std::uint64_t randomSeed();
+};
@@ -16,5 +16,12 @@ public:
     virtual void sRender() = 0;
     virtual void doAction(const Command& command) = 0;
 
+    // called before each tick's input is applied; scenes that draw between
+    // ticks keep the state they interpolate from here
+    virtual void beginTick() {}
+
+    // headless runs stop stepping a scene once it reports it has ended
+    virtual bool hasEnded() const { return false; }
+
     const std::map<sf::Keyboard::Key, std::string>& getActionMap() const { return _actionMap; }
 };
@@ -8,6 +8,8 @@
 #include "GameEngine.h"
 #include <iostream>
 #include <cmath>
+#include <iomanip>
+#include <sstream>
 
 #include "MusicPlayer.h"
 #include "SoundPlayer.h"
@@ -15,11 +17,37 @@
 struct CTransform;
 struct CCollision;
 
+namespace {
+    const float LaneX[] = { 450.f, 640.f, 830.f };
+    const int LaneCount = 3;
+
+    const sf::Time AnimationFrameTime = sf::seconds(0.1f);
+
+    // draw order inside one SpriteBatch flush
+    enum RenderLayer {
+        BackgroundLayer,
+        RoadLayer,
+        ObjectLayer,
+        DogLayer,
+        HomeLayer,
+        HudLayer,
+        OverlayLayer
+    };
+}
+
 Scene_Game::Scene_Game(GameEngine* game)
-    : _game(game), _backgroundScene("background.png") {
+    : _game(game), _backgroundScene("background")
+    , _carLanes(LaneCount)
+    , _pickupLanes(LaneCount)
+    , _seed(game->random().nextSession())
+    , _spawnRng(RandomService(_seed).stream("spawn"))
+    , _effectRng(RandomService(_seed).stream("effects"))
+    , _renderRng(RandomService(_seed).stream("render")) {
 
     initActionMap();
+    initEntityTags();
     initTextures();
+    initSounds();
     initUI();
     initGameParameters();
     initHealthSystem();
@@ -28,12 +56,15 @@ Scene_Game::Scene_Game(GameEngine* game)
     initCarFrames();
     initHomeAndGameStates();
     initGameState();
-    initClocks();
+    initTimers();
+    beginTick();
 
     MusicPlayer::getInstance().play("background");
     MusicPlayer::getInstance().setVolume(100);
 
-    std::cout << "Scene_Game initialized successfully" << std::endl;
+    _game->beginSession(_seed);
+
+    std::cout << "Scene_Game initialized successfully, seed " << _seed << std::endl;
 }
 
 void Scene_Game::initActionMap() {
@@ -43,21 +74,34 @@ void Scene_Game::initActionMap() {
     _actionMap[sf::Keyboard::D] = "MOVE_RIGHT";
     _actionMap[sf::Keyboard::R] = "RESTART";
     _actionMap[sf::Keyboard::Escape] = "EXIT";
+    _actionMap[sf::Keyboard::F1] = "TOGGLE_STATISTICS";
+}
+
+void Scene_Game::initEntityTags() {
+    _carTag = _entityManager.registerTag("car");
+    _boneTag = _entityManager.registerTag("bone");
+    _cookieTag = _entityManager.registerTag("cookie");
 }
 
 void Scene_Game::initTextures() {
+    _backgroundTexture = TextureRef("background");
+    _roadTexture = TextureRef("road");
+    _dogTexture = TextureRef("dog");
+    _carSheetTexture = TextureRef("cars");
+    _boneTexture = TextureRef("bone");
+    _homeTexture = TextureRef("home");
+    _gameOverTexture = TextureRef("gameover");
+    _winTexture = TextureRef("winner");
+    _cookieTexture = TextureRef("cookie");
+    _heartTexture = TextureRef("heart");
+}
+
+void Scene_Game::initSounds() {
     auto& assets = Assets::getInstance();
 
-    _backgroundTexture = assets.getTexture("background");
-    _roadTexture = assets.getTexture("road");
-    _dogTexture = assets.getTexture("dog");
-    _carSheetTexture = assets.getTexture("cars");
-    _boneTexture = assets.getTexture("bone");
-    _homeTexture = assets.getTexture("home");
-    _gameOverTexture = assets.getTexture("gameover");
-    _winTexture = assets.getTexture("winner");
-    _cookieTexture = assets.getTexture("cookie");
-    _heartTexture = assets.getTexture("heart");
+    _hitSound = assets.soundId("hit");
+    _collectSound = assets.soundId("collect");
+    _winSound = assets.soundId("win");
 }
 
 void Scene_Game::initUI() {
@@ -73,42 +117,26 @@ void Scene_Game::initUI() {
 }
 
 void Scene_Game::initGameParameters() {
-    auto& assets = Assets::getInstance();
-
-    _dogSpeed = assets.getFloat("DogSpeed", 25.0f);
-    _carSpeed = assets.getFloat("CarSpeed", 100.0f);
-    _backgroundScrollSpeed = assets.getFloat("BackgroundScrollSpeed", 200.0f);
-    _spawnInterval = assets.getFloat("CarSpawnInterval", 1.5f);
-    _boneSpawnInterval = assets.getFloat("BoneSpawnInterval", 3.0f);
-    _requiredBones = assets.getInt("RequiredBones", 10);
-    _leftBoundary = assets.getFloat("LeftBoundary", 175.0f);
-    _cookieSpawnInterval = assets.getFloat("CookieSpawnInterval", 4.0f);
-    _requiredCookies = assets.getInt("RequiredCookies", 10);
-    WIN_DISTANCE = assets.getFloat("WinDistance", 3000.0f);
-
-    _hitAnimationDuration = assets.getFloat("HitAnimation.Duration", 2.0f);
-    _invincibilityDuration = assets.getFloat("HitAnimation.InvincibilityDuration", 2.0f);
-    _dogHealth = assets.getInt("HitAnimation.DogHealth", 3);
-    _particleGravity = assets.getFloat("HitAnimation.ParticleGravity", 200.0f);
+    _tuning = Tuning::current();
+    _dogHealth = _tuning->dogHealth;
 }
 
 void Scene_Game::initSprites() {
     auto& assets = Assets::getInstance();
 
-    _backgroundSprite1.setTexture(_backgroundTexture);
-    _backgroundSprite2.setTexture(_backgroundTexture);
+    _backgroundTexture->applyTo(_backgroundSprite1);
+    _backgroundTexture->applyTo(_backgroundSprite2);
     _backgroundSprite1.setPosition(0, 0);
-    _backgroundSprite2.setPosition(0, -static_cast<float>(_backgroundTexture.getSize().y));
+    _backgroundSprite2.setPosition(0, -static_cast<float>(_backgroundTexture->getSize().y));
 
-    _roadSprite1.setTexture(_roadTexture);
-    _roadSprite2.setTexture(_roadTexture);
+    _roadTexture->applyTo(_roadSprite1);
+    _roadTexture->applyTo(_roadSprite2);
     sf::Vector2f roadPos = assets.getVector("RoadPosition", sf::Vector2f(470.f, 0.f));
     _roadSprite1.setPosition(roadPos);
-    _roadSprite2.setPosition(roadPos.x, -static_cast<float>(_roadTexture.getSize().y));
+    _roadSprite2.setPosition(roadPos.x, -static_cast<float>(_roadTexture->getSize().y));
 
-    _dogTexture.setSmooth(true);
-    _dogSprite.setTexture(_dogTexture);
-    _dogSprite.setTextureRect(sf::IntRect(0, 0, 32, 32));
+    _dogTexture->applyTo(_dogSprite);
+    _dogSprite.setTextureRect(_dogTexture->subRect(sf::IntRect(0, 0, 32, 32)));
     _dogPosition = assets.getVector("DogStartPosition", sf::Vector2f(640.f, 384.f));
     _dogSprite.setPosition(_dogPosition);
     _dogSprite.setScale(assets.getFloat("DogScale", 2.0f), assets.getFloat("DogScale", 2.0f));
@@ -122,12 +150,12 @@ void Scene_Game::initCarFrames() {
     for (int i = 0; i < numCars; i++) {
         int x = i * carWidth;
         int y = 0;
-        _carFrames.push_back(sf::IntRect(x, y, carWidth, carHeight));
+        _carFrames.push_back(_carSheetTexture->subRect(sf::IntRect(x, y, carWidth, carHeight)));
     }
 }
 
 void Scene_Game::initHomeAndGameStates() {
-    _homeSprite.setTexture(_homeTexture);
+    _homeTexture->applyTo(_homeSprite);
     _homeSprite.setScale(0.2f, 0.2f);
     sf::FloatRect bounds = _homeSprite.getLocalBounds();
     _homeSprite.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
@@ -135,17 +163,18 @@ void Scene_Game::initHomeAndGameStates() {
         static_cast<float>(_game->windowSize().x) / 1.2f,
         80.f
     );
+    _homeBounds = _homeSprite.getGlobalBounds();
 
-    _gameOverSprite.setTexture(_gameOverTexture);
+    _gameOverTexture->applyTo(_gameOverSprite);
     _gameOverSprite.setScale(
-        static_cast<float>(_game->windowSize().x) / _gameOverTexture.getSize().x,
-        static_cast<float>(_game->windowSize().y) / _gameOverTexture.getSize().y
+        static_cast<float>(_game->windowSize().x) / _gameOverTexture->getSize().x,
+        static_cast<float>(_game->windowSize().y) / _gameOverTexture->getSize().y
     );
 
-    _winSprite.setTexture(_winTexture);
+    _winTexture->applyTo(_winSprite);
     _winSprite.setScale(
-        static_cast<float>(_game->windowSize().x) / _winTexture.getSize().x,
-        static_cast<float>(_game->windowSize().y) / _winTexture.getSize().y
+        static_cast<float>(_game->windowSize().x) / _winTexture->getSize().x,
+        static_cast<float>(_game->windowSize().y) / _winTexture->getSize().y
     );
 }
 
@@ -160,11 +189,32 @@ void Scene_Game::initGameState() {
     _cookieCount = 0;
 }
 
-void Scene_Game::initClocks() {
-    _carSpawnClock.restart();
-    _boneSpawnClock.restart();
-    _animationClock.restart();
-    _cookieSpawnClock.restart();
+// Advanced by the scaled dt in update, so spawning slows down with the hit
+// slow motion and stops while paused, the hit animation plays or the game is over
+void Scene_Game::initTimers() {
+    _scheduler.clear();
+    _carSpawnTimer = _scheduler.every(sf::seconds(_tuning->carSpawnInterval), [this] { spawnCar(); });
+    _boneSpawnTimer = _scheduler.every(sf::seconds(_tuning->boneSpawnInterval), [this] { spawnBone(); });
+    _cookieSpawnTimer = _scheduler.every(sf::seconds(_tuning->cookieSpawnInterval), [this] { spawnCookie(); });
+
+    // the flag stays up until a frame is shown, see nextAnimationFrame
+    _animationFrameDue = false;
+    _animationTimer = _scheduler.every(AnimationFrameTime, [this] { _animationFrameDue = true; });
+}
+
+// what sRender interpolates from, see GameEngine::getRenderAlpha. Runs before
+// the tick's commands, which already move the dog.
+void Scene_Game::beginTick() {
+    for (auto& tfm : _entityManager.getComponents<CTransform>().components())
+        tfm.savePrevious();
+    _dogPrevPosition = _dogSprite.getPosition();
+    _scrolledThisTick = 0.f;
+}
+
+// the next frame is due a full frame time after this one was shown
+void Scene_Game::nextAnimationFrame() {
+    _animationFrameDue = false;
+    _scheduler.restart(_animationTimer);
 }
 
 Scene_Game::~Scene_Game() {
@@ -173,12 +223,14 @@ Scene_Game::~Scene_Game() {
 }
 
 void Scene_Game::update(sf::Time dt) {
+    sReloadTuning();
+
     sf::Time scaledDt = dt * _gameTimeScale;
 
     if (_invincibilityTime > 0.0f) {
         _invincibilityTime -= dt.asSeconds();
 
-        int flashFrequency = Assets::getInstance().getInt("InvincibilityFlashFrequency", 8);
+        int flashFrequency = _tuning->invincibilityFlashFrequency;
         bool visible = static_cast<int>(_invincibilityTime * flashFrequency) % 2 == 0;
         _dogSprite.setColor(visible ? sf::Color::White : sf::Color(255, 255, 255, 128));
     }
@@ -199,10 +251,12 @@ void Scene_Game::update(sf::Time dt) {
 
     sMovement(scaledDt);
     sEntityMovement(scaledDt);
-    sObjectMovement(scaledDt);
+    _dogBounds = _dogSprite.getGlobalBounds();
+    sCulling();
+    sBroadPhase();
     sCollision();
     sCollectibles();
-    sSpawnObjects(scaledDt);
+    _scheduler.advance(scaledDt);
     sUpdateProgress();
 
     if (_isVictoryAnimation) {
@@ -215,62 +269,82 @@ void Scene_Game::update(sf::Time dt) {
 
 
 void Scene_Game::sRender() {
-    sf::View originalView = _game->window().getView();
+    auto& window = _game->window();
+    sf::View originalView = window.getView();
     sf::View view = originalView;
 
     if (_screenShake > 0.0f) {
-        float shakeX = (rand() % 100 - 50) * 0.01f * _screenShake;
-        float shakeY = (rand() % 100 - 50) * 0.01f * _screenShake;
+        float shakeX = _renderRng.range(-0.5f, 0.5f) * _screenShake;
+        float shakeY = _renderRng.range(-0.5f, 0.5f) * _screenShake;
         view.setCenter(view.getCenter() + sf::Vector2f(shakeX, shakeY));
-        _game->window().setView(view);
+        window.setView(view);
+    }
+
+    // sprites are queued per texture and layer; anything drawn through
+    // drawImmediate flushes the queue first so it still lands on top
+    _spriteBatch.beginFrame();
+
+    // moving things are drawn between the last two ticks
+    const float alpha = _game->getRenderAlpha();
+
+    // the tiles all scroll together, so one offset covers them and a tile
+    // wrapping to the top this tick still lines up with the other
+    sf::Transform scroll;
+    scroll.translate(0.f, -_scrolledThisTick * (1.f - alpha));
+    auto drawScrolled = [&](const sf::Sprite& tile, int layer) {
+        _spriteBatch.draw(*tile.getTexture(), tile.getTextureRect(),
+            scroll * tile.getTransform(), tile.getColor(), layer);
+    };
+    drawScrolled(_backgroundSprite1, BackgroundLayer);
+    drawScrolled(_backgroundSprite2, BackgroundLayer);
+    drawScrolled(_roadSprite1, RoadLayer);
+    drawScrolled(_roadSprite2, RoadLayer);
+
+    // entities destroyed this tick stay in the pools until the next update
+    for (auto [e, sprite, tfm] : _entityManager.view<CSprite, CTransform>()) {
+        if (e.isActive() && sprite.sprite.getTexture()) {
+            sf::Transform transform;
+            transform.translate(tfm.getRenderOffset(alpha));
+            transform.combine(tfm.getTransform());
+            _spriteBatch.draw(*sprite.sprite.getTexture(), sprite.sprite.getTextureRect(),
+                transform, sprite.sprite.getColor(), ObjectLayer);
+        }
     }
 
-    _game->window().draw(_backgroundSprite1);
-    _game->window().draw(_backgroundSprite2);
-    _game->window().draw(_roadSprite1);
-    _game->window().draw(_roadSprite2);
-
-    for (const auto& car : _cars)
-        _game->window().draw(car.sprite);
-
-    for (const auto& bone : _bones)
-        _game->window().draw(bone);
-
-    for (const auto& cookie : _cookies)
-        _game->window().draw(cookie);
-
-    _game->window().draw(_dogSprite);
+    if (_dogSprite.getTexture()) {
+        sf::Transform dogTransform;
+        dogTransform.translate((_dogPrevPosition - _dogSprite.getPosition()) * (1.f - alpha));
+        dogTransform.combine(_dogSprite.getTransform());
+        _spriteBatch.draw(*_dogSprite.getTexture(), _dogSprite.getTextureRect(),
+            dogTransform, _dogSprite.getColor(), DogLayer);
+    }
 
     if (_canReachHome && !_isWin) {
         if (_isVictoryAnimation) {
-            _game->window().draw(_homeGlow);
+            _spriteBatch.drawImmediate(window, _homeGlow);
         }
-        _game->window().draw(_homeSprite);
+        _spriteBatch.draw(_homeSprite, HomeLayer);
     }
 
     if (_isVictoryAnimation) {
-        for (const auto& confetti : _confettiParticles) {
-            _game->window().draw(confetti);
-        }
+        _spriteBatch.drawImmediate(window, _confettiParticles);
     }
 
 
-    for (const auto& particle : _impactParticles) {
-        _game->window().draw(particle);
-    }
+    _spriteBatch.drawImmediate(window, _impactParticles);
 
-    _game->window().draw(_flashOverlay);
+    _spriteBatch.drawImmediate(window, _flashOverlay);
 
     for (const auto& heart : _healthIcons) {
-        _game->window().draw(heart);
+        _spriteBatch.draw(heart, HudLayer);
     }
 
     if (_isGameOver) {
-        _game->window().draw(_gameOverSprite);
+        _spriteBatch.draw(_gameOverSprite, OverlayLayer);
     }
 
     if (_isWin) {
-        _game->window().draw(_winSprite);
+        _spriteBatch.draw(_winSprite, OverlayLayer);
     }
 
     if (_isGameOver || _isWin) {
@@ -288,17 +362,23 @@ void Scene_Game::sRender() {
             _game->windowSize().y - 100.0f
         );
 
-        _game->window().draw(restartText);
+        _spriteBatch.drawImmediate(window, restartText);
     }
 
     _distanceText.setString("Distance: " + std::to_string(static_cast<int>(_dogDistance)) +
         " m\nBones: " + std::to_string(_boneCount) +
         "\nCookies: " + std::to_string(_cookieCount));
 
-    _game->window().draw(_distanceText);
+    _spriteBatch.drawImmediate(window, _distanceText);
+
+    if (_showStatistics) {
+        _spriteBatch.drawImmediate(window, _statisticsText);
+    }
+
+    _spriteBatch.flush(window);
 
     if (_screenShake > 0.0f) {
-        _game->window().setView(originalView);
+        window.setView(originalView);
     }
 }
 
@@ -313,33 +393,33 @@ void Scene_Game::doAction(const Command& command) {
 
     if (command.getName() == "MOVE_UP") {
         sf::Vector2f oldPosition = _dogPosition;
-        _dogPosition.y -= _dogSpeed * command.getDeltaTime().asSeconds();
+        _dogPosition.y -= _tuning->dogSpeed * command.getDeltaTime().asSeconds();
 
-        _dogSprite.setTextureRect(sf::IntRect(0, 96, 32, 32));
+        _dogSprite.setTextureRect(_dogTexture->subRect(sf::IntRect(0, 96, 32, 32)));
 
         float verticalDistanceMoved = std::abs(_dogPosition.y - oldPosition.y);
         _dogDistance += verticalDistanceMoved;
     }
     else if (command.getName() == "MOVE_DOWN") {
         sf::Vector2f oldPosition = _dogPosition;
-        _dogPosition.y += _dogSpeed * command.getDeltaTime().asSeconds();
+        _dogPosition.y += _tuning->dogSpeed * command.getDeltaTime().asSeconds();
 
-        _dogSprite.setTextureRect(sf::IntRect(0, 0, 32, 32));
+        _dogSprite.setTextureRect(_dogTexture->subRect(sf::IntRect(0, 0, 32, 32)));
 
         float verticalDistanceMoved = std::abs(_dogPosition.y - oldPosition.y);
         _dogDistance -= verticalDistanceMoved;
         _dogDistance = std::max(0.0f, _dogDistance);
     }
     else if (command.getName() == "MOVE_LEFT") {
-        float newX = _dogPosition.x - _dogSpeed * command.getDeltaTime().asSeconds();
-        if (newX >= _leftBoundary) {
+        float newX = _dogPosition.x - _tuning->dogSpeed * command.getDeltaTime().asSeconds();
+        if (newX >= _tuning->leftBoundary) {
             _dogPosition.x = newX;
-            _dogSprite.setTextureRect(sf::IntRect(0, 32, 32, 32));
+            _dogSprite.setTextureRect(_dogTexture->subRect(sf::IntRect(0, 32, 32, 32)));
         }
     }
     else if (command.getName() == "MOVE_RIGHT") {
-        _dogPosition.x += _dogSpeed * command.getDeltaTime().asSeconds();
-        _dogSprite.setTextureRect(sf::IntRect(0, 64, 32, 32));
+        _dogPosition.x += _tuning->dogSpeed * command.getDeltaTime().asSeconds();
+        _dogSprite.setTextureRect(_dogTexture->subRect(sf::IntRect(0, 64, 32, 32)));
     }
     else if (command.getName() == "RESTART" && _isGameOver) {
         resetGame();
@@ -347,8 +427,11 @@ void Scene_Game::doAction(const Command& command) {
     else if (command.getName() == "EXIT") {
         _game->quit();
     }
+    else if (command.getName() == "TOGGLE_STATISTICS" && command.getType() == "START") {
+        _showStatistics = !_showStatistics;
+    }
 
-    sf::Vector2u windowSize = _game->window().getSize();
+    sf::Vector2f windowSize = _game->windowSize();
     _dogPosition.x = std::max(0.f, std::min(_dogPosition.x, windowSize.x - 32.f));
     _dogPosition.y = std::max(0.f, std::min(_dogPosition.y, windowSize.y - 32.f));
 
@@ -359,39 +442,38 @@ void Scene_Game::doAction(const Command& command) {
 void Scene_Game::sEntityMovement(sf::Time dt) {
     if (_isWin) return; 
 
-    for (auto& e : _entityManager.getEntities()) {
-        if (e->hasComponent<CTransform>()) {
-            auto& tfm = e->getComponent<CTransform>();
-            tfm.pos += tfm.vel * dt.asSeconds();
-            keepInBounds(*e);
-        }
-    }
+    for (auto& tfm : _entityManager.getComponents<CTransform>().components())
+        tfm.move(tfm.vel * dt.asSeconds());
+
+    for (auto [e, tfm, col] : _entityManager.view<CTransform, CCollision>())
+        keepInBounds(tfm, col.radius);
 }
 
 
 void Scene_Game::sScrollBackground(sf::Time dt) {
-    float scrollAmount = _backgroundScrollSpeed * dt.asSeconds(); 
+    float scrollAmount = _tuning->backgroundScrollSpeed * dt.asSeconds(); 
+    _scrolledThisTick += scrollAmount;
 
     _backgroundSprite1.move(0, scrollAmount);
     _backgroundSprite2.move(0, scrollAmount);
 
-    if (_backgroundSprite1.getPosition().y >= static_cast<float>(_backgroundTexture.getSize().y)) {
-        _backgroundSprite1.setPosition(0, _backgroundSprite2.getPosition().y - static_cast<float>(_backgroundTexture.getSize().y));
+    if (_backgroundSprite1.getPosition().y >= static_cast<float>(_backgroundTexture->getSize().y)) {
+        _backgroundSprite1.setPosition(0, _backgroundSprite2.getPosition().y - static_cast<float>(_backgroundTexture->getSize().y));
     }
 
-    if (_backgroundSprite2.getPosition().y >= static_cast<float>(_backgroundTexture.getSize().y)) {
-        _backgroundSprite2.setPosition(0, _backgroundSprite1.getPosition().y - static_cast<float>(_backgroundTexture.getSize().y));
+    if (_backgroundSprite2.getPosition().y >= static_cast<float>(_backgroundTexture->getSize().y)) {
+        _backgroundSprite2.setPosition(0, _backgroundSprite1.getPosition().y - static_cast<float>(_backgroundTexture->getSize().y));
     }
 
     _roadSprite1.move(0, scrollAmount);
     _roadSprite2.move(0, scrollAmount);
 
-    if (_roadSprite1.getPosition().y >= static_cast<float>(_roadTexture.getSize().y)) {
-        _roadSprite1.setPosition(_roadSprite1.getPosition().x, _roadSprite2.getPosition().y - _roadTexture.getSize().y);
+    if (_roadSprite1.getPosition().y >= static_cast<float>(_roadTexture->getSize().y)) {
+        _roadSprite1.setPosition(_roadSprite1.getPosition().x, _roadSprite2.getPosition().y - _roadTexture->getSize().y);
     }
 
-    if (_roadSprite2.getPosition().y >= static_cast<float>(_roadTexture.getSize().y)) {
-        _roadSprite2.setPosition(_roadSprite2.getPosition().x, _roadSprite1.getPosition().y - _roadTexture.getSize().y);
+    if (_roadSprite2.getPosition().y >= static_cast<float>(_roadTexture->getSize().y)) {
+        _roadSprite2.setPosition(_roadSprite2.getPosition().x, _roadSprite1.getPosition().y - _roadTexture->getSize().y);
     }
 }
 
@@ -399,28 +481,25 @@ void Scene_Game::sScrollBackground(sf::Time dt) {
 void Scene_Game::sCollision() {
     if (_invincibilityTime > 0.0f || _isHitAnimation) return;
 
-    for (const auto& car : _cars) {
-        sf::FloatRect dogBounds = _dogSprite.getGlobalBounds();
-        sf::FloatRect carBounds = car.sprite.getGlobalBounds();
-
-        dogBounds.left += 10;
-        dogBounds.width -= 20;
-        dogBounds.top += 5;
-        dogBounds.height -= 10;
+    sf::FloatRect dogBounds = _dogBounds;
+    dogBounds.left += 10;
+    dogBounds.width -= 20;
+    dogBounds.top += 5;
+    dogBounds.height -= 10;
 
-        if (dogBounds.intersects(carBounds)) {
-            _dogHealth--;
+    _broadPhaseHits.clear();
+    _carLanes.query(dogBounds, _broadPhaseHits);
 
-            if (_healthIcons.size() > 0) {
-                _healthIcons.pop_back();
-            }
+    if (!_broadPhaseHits.empty()) {
+        _dogHealth--;
 
-            startHitAnimation(car);
+        if (_healthIcons.size() > 0) {
+            _healthIcons.pop_back();
+        }
 
-            _invincibilityTime = _invincibilityDuration;
+        startHitAnimation(_entityManager.getComponent<CCar>(_broadPhaseHits.front()));
 
-            return;
-        }
+        _invincibilityTime = _tuning->invincibilityDuration;
     }
 }
 
@@ -430,26 +509,26 @@ void Scene_Game::sMovement(sf::Time dt) {
     bool isMovingUp = false;
     bool isMovingDown = false;
 
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::W)) {
+    if (_game->isKeyPressed(sf::Keyboard::W)) {
         direction.y -= 1;
-        _dogSprite.setTextureRect(sf::IntRect(0, 96, 32, 32));
+        _dogSprite.setTextureRect(_dogTexture->subRect(sf::IntRect(0, 96, 32, 32)));
         isMoving = true;
         isMovingUp = true;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::S)) {
+    if (_game->isKeyPressed(sf::Keyboard::S)) {
         direction.y += 1;
-        _dogSprite.setTextureRect(sf::IntRect(0, 0, 32, 32));
+        _dogSprite.setTextureRect(_dogTexture->subRect(sf::IntRect(0, 0, 32, 32)));
         isMoving = true;
         isMovingDown = true;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)) {
+    if (_game->isKeyPressed(sf::Keyboard::A)) {
         direction.x -= 1;
-        _dogSprite.setTextureRect(sf::IntRect(0, 32, 32, 32));
+        _dogSprite.setTextureRect(_dogTexture->subRect(sf::IntRect(0, 32, 32, 32)));
         isMoving = true;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) {
+    if (_game->isKeyPressed(sf::Keyboard::D)) {
         direction.x += 1;
-        _dogSprite.setTextureRect(sf::IntRect(0, 64, 32, 32));
+        _dogSprite.setTextureRect(_dogTexture->subRect(sf::IntRect(0, 64, 32, 32)));
         isMoving = true;
     }
 
@@ -460,17 +539,17 @@ void Scene_Game::sMovement(sf::Time dt) {
         }
 
         sf::Vector2f oldPosition = _dogPosition;
-        sf::Vector2f newPosition = _dogPosition + direction * _dogSpeed * dt.asSeconds();
+        sf::Vector2f newPosition = _dogPosition + direction * _tuning->dogSpeed * dt.asSeconds();
 
         // Check left boundary
-        if (newPosition.x < _leftBoundary) {
-            newPosition.x = _leftBoundary;
+        if (newPosition.x < _tuning->leftBoundary) {
+            newPosition.x = _tuning->leftBoundary;
         }
 
         _dogPosition = newPosition;
 
-        sf::Vector2u windowSize = _game->window().getSize();
-        _dogPosition.x = std::max(_leftBoundary, std::min(_dogPosition.x, windowSize.x - 32.f));  // Use _leftBoundary instead of 0.f
+        sf::Vector2f windowSize = _game->windowSize();
+        _dogPosition.x = std::max(_tuning->leftBoundary, std::min(_dogPosition.x, windowSize.x - 32.f));  // Use the left boundary instead of 0.f
         _dogPosition.y = std::max(0.f, std::min(_dogPosition.y, windowSize.y - 32.f));
 
         _dogSprite.setPosition(_dogPosition);
@@ -488,223 +567,187 @@ void Scene_Game::sMovement(sf::Time dt) {
             sScrollBackground(dt);
         }
 
-        if (isMoving && _animationClock.getElapsedTime().asSeconds() > 0.1f) {
+        if (isMoving && _animationFrameDue) {
             _dogAnimationFrame = (_dogAnimationFrame + 1) % 3;
             sf::IntRect textureRect = _dogSprite.getTextureRect();
             int row = textureRect.top / 32;
-            textureRect.left = _dogAnimationFrame * 32;
+            textureRect.left = _dogTexture->rect.left + _dogAnimationFrame * 32;
             _dogSprite.setTextureRect(textureRect);
-            _animationClock.restart();
+            nextAnimationFrame();
         }
     }
 }
 
-void Scene_Game::sSpawnObjects(sf::Time dt) {
-    if (_boneSpawnClock.getElapsedTime().asSeconds() > _boneSpawnInterval) {
-        spawnBone();
-        _boneSpawnClock.restart();
-    }
-
-    if (_cookieSpawnClock.getElapsedTime().asSeconds() > _cookieSpawnInterval) {
-        spawnCookie();
-        _cookieSpawnClock.restart();
-    }
-
-    if (_carSpawnClock.getElapsedTime().asSeconds() >= _spawnInterval) {
-        spawnCar();
-        _carSpawnClock.restart();
-    }
-}
-
 void Scene_Game::spawnBone() {
-    sf::Sprite bone;
-    bone.setTexture(_boneTexture);
-    bone.setScale(0.1f, 0.1f);
-
     bool validPosition = false;
     int attempts = 0;
-    int laneX[] = { 450, 640, 830 };
+    int lane = 0;
+    sf::Vector2f position;
 
     while (!validPosition && attempts < 5) {
-        int lane = rand() % 3;
-        float xPos = static_cast<float>(laneX[lane]);
-        float yPos = -100.f - (rand() % 100); 
-
-        bone.setPosition(xPos, yPos);
-
-        validPosition = true;
-        for (const auto& cookie : _cookies) {
-            if (areSpritesTooClose(bone, cookie)) {
-                validPosition = false;
-                break;
-            }
-        }
+        lane = static_cast<int>(_spawnRng.below(LaneCount));
+        float xPos = LaneX[lane];
+        float yPos = -100.f - _spawnRng.range(0, 99); 
+
+        position = sf::Vector2f(xPos, yPos);
+
+        validPosition = !_pickupLanes.anyNear(position, 50.0f);
 
         attempts++;
     }
 
     if (validPosition) {
-        _bones.push_back(bone);
+        auto bone = _entityManager.addEntity(_boneTag);
+        bone.addComponent<CCollectible>(CCollectible::Bone);
+        auto& sprite = bone.addComponent<CSprite>(*_boneTexture).sprite;
+        auto& tfm = bone.addComponent<CTransform>(position, sf::Vector2f(0.f, 100.f));
+        tfm.setScale(sf::Vector2f(0.1f, 0.1f));
+        tfm.setLocalBounds(sprite.getLocalBounds());
+        _pickupLanes.insert(lane, bone.getId(), tfm.getGlobalBounds(), position);
     }
 }
 
 void Scene_Game::spawnCookie() {
-    sf::Sprite cookie;
-    cookie.setTexture(_cookieTexture);
-    cookie.setScale(0.1f, 0.1f);
-
     bool validPosition = false;
     int attempts = 0;
-    int laneX[] = { 450, 640, 830 };
+    int lane = 0;
+    sf::Vector2f position;
 
     while (!validPosition && attempts < 5) {
-        int lane = rand() % 3;
-        float xPos = static_cast<float>(laneX[lane]);
-        float yPos = -100.f - (rand() % 100);
-
-        cookie.setPosition(xPos, yPos);
-
-        validPosition = true;
-        for (const auto& bone : _bones) {
-            if (areSpritesTooClose(cookie, bone)) {
-                validPosition = false;
-                break;
-            }
-        }
+        lane = static_cast<int>(_spawnRng.below(LaneCount));
+        float xPos = LaneX[lane];
+        float yPos = -100.f - _spawnRng.range(0, 99);
+
+        position = sf::Vector2f(xPos, yPos);
+
+        validPosition = !_pickupLanes.anyNear(position, 50.0f);
 
         attempts++;
     }
 
     if (validPosition) {
-        _cookies.push_back(cookie);
+        auto cookie = _entityManager.addEntity(_cookieTag);
+        cookie.addComponent<CCollectible>(CCollectible::Cookie);
+        auto& sprite = cookie.addComponent<CSprite>(*_cookieTexture).sprite;
+        auto& tfm = cookie.addComponent<CTransform>(position, sf::Vector2f(0.f, 100.f));
+        tfm.setScale(sf::Vector2f(0.1f, 0.1f));
+        tfm.setLocalBounds(sprite.getLocalBounds());
+        _pickupLanes.insert(lane, cookie.getId(), tfm.getGlobalBounds(), position);
     }
 }
 
 void Scene_Game::spawnCar() {
     bool validPosition = false;
     int attempts = 0;
-    Car newCar;
+    bool goingDown = true;
+    int carIndex = 0;
+    int laneIndex = 0;
+    sf::Vector2f position;
 
     while (!validPosition && attempts < 5) {
-        newCar.sprite.setTexture(_carSheetTexture);
-        int carIndex = rand() % 3;
-        newCar.sprite.setTextureRect(_carFrames[carIndex]);
+        carIndex = static_cast<int>(_spawnRng.below(3));
 
-        int laneX[] = { 450, 640, 830 };
-        int laneIndex = rand() % 3;
+        laneIndex = static_cast<int>(_spawnRng.below(LaneCount));
 
         float startY;
         if (laneIndex == 2) {
-            startY = static_cast<float>(_game->window().getSize().y + 220);
-            newCar.goingDown = false;
-            newCar.sprite.setScale(0.5f, -0.5f);
-            newCar.sprite.setOrigin(0, newCar.sprite.getLocalBounds().height);
+            startY = _game->windowSize().y + 220.f;
+            goingDown = false;
         }
         else {
             startY = -220.f;
-            newCar.goingDown = true;
-            newCar.sprite.setScale(0.5f, 0.5f);
+            goingDown = true;
         }
 
-        startY += (rand() % 100) - 50;
-        newCar.sprite.setPosition(static_cast<float>(laneX[laneIndex]), startY);
+        startY += _spawnRng.range(-50, 49);
+        position = sf::Vector2f(LaneX[laneIndex], startY);
 
-        validPosition = true;
-        for (const auto& car : _cars) {
-            if (areSpritesTooClose(newCar.sprite, car.sprite, 250.0f)) {
-                validPosition = false;
-                break;
-            }
-        }
+        validPosition = !_carLanes.anyNear(position, 250.0f);
 
         attempts++;
     }
 
     if (validPosition) {
-        _cars.push_back(newCar);
+        auto car = _entityManager.addEntity(_carTag);
+        car.addComponent<CCar>(goingDown);
+
+        auto& sprite = car.addComponent<CSprite>(*_carSheetTexture).sprite;
+        sprite.setTextureRect(_carFrames[carIndex]);
+
+        auto& tfm = car.addComponent<CTransform>(position, sf::Vector2f(0.f, (goingDown ? 1.f : -1.f) * _tuning->carSpeed));
+        tfm.setLocalBounds(sprite.getLocalBounds());
+        if (goingDown) {
+            tfm.setScale(sf::Vector2f(0.5f, 0.5f));
+        }
+        else {
+            tfm.setScale(sf::Vector2f(0.5f, -0.5f));
+            tfm.setOrigin(sf::Vector2f(0.f, sprite.getLocalBounds().height));
+        }
+        _carLanes.insert(laneIndex, car.getId(), tfm.getGlobalBounds(), position);
     }
 }
 
-void Scene_Game::sObjectMovement(sf::Time dt) {
-    for (auto& car : _cars) {
-        float dy = (car.goingDown ? 1.f : -1.f) * _carSpeed * dt.asSeconds();
-        car.sprite.move(0, dy);
-    }
+void Scene_Game::sCulling() {
+    float windowHeight = _game->windowSize().y;
 
-    _cars.erase(std::remove_if(_cars.begin(), _cars.end(), [&](const Car& c) {
-        float y = c.sprite.getPosition().y;
-        return (c.goingDown && y > _game->window().getSize().y) || (!c.goingDown && y < -220.f);
-        }), _cars.end());
+    for (auto [e, tfm, car] : _entityManager.view<CTransform, CCar>()) {
+        float y = tfm.getPosition().y;
+        if ((car.goingDown && y > windowHeight) || (!car.goingDown && y < -220.f))
+            e.destroy();
+    }
 
-    for (auto& bone : _bones) {
-        bone.move(0, 100.f * dt.asSeconds());
+    for (auto [e, tfm, item] : _entityManager.view<CTransform, CCollectible>()) {
+        if (tfm.getPosition().y > windowHeight)
+            e.destroy();
     }
+}
 
-    _bones.erase(std::remove_if(_bones.begin(), _bones.end(), [&](sf::Sprite& b) {
-        return b.getPosition().y > _game->window().getSize().y;
-        }), _bones.end());
+// entries are added at spawn time, here they only pick up the new bounds and re-sort
+void Scene_Game::sBroadPhase() {
+    auto fetch = [this](EntityId id, LaneSweep::Entry& entry) {
+        if (!_entityManager.isActive(id))
+            return false;
 
-    for (auto& cookie : _cookies) {
-        cookie.move(0, 100.f * dt.asSeconds());
-    }
+        const auto& tfm = _entityManager.getComponent<CTransform>(id);
+        entry.bounds = tfm.getGlobalBounds();
+        entry.position = tfm.getPosition();
+        return true;
+    };
 
-    _cookies.erase(std::remove_if(_cookies.begin(), _cookies.end(), [&](sf::Sprite& c) {
-        return c.getPosition().y > _game->window().getSize().y;
-        }), _cookies.end());
+    _carLanes.refresh(fetch);
+    _pickupLanes.refresh(fetch);
 }
 
 void Scene_Game::sCollectibles() {
-    for (auto it = _bones.begin(); it != _bones.end();) {
-        if (_dogSprite.getGlobalBounds().intersects(it->getGlobalBounds())) {
-            _boneCount++;
-            SoundPlayer::getInstance().play("collect", it->getPosition());
-            it = _bones.erase(it);
-        }
-        else {
-            ++it;
-        }
-    }
+    _broadPhaseHits.clear();
+    _pickupLanes.query(_dogBounds, _broadPhaseHits);
+
+    for (auto id : _broadPhaseHits) {
+        auto item = _entityManager.getEntity(id);
 
-    for (auto it = _cookies.begin(); it != _cookies.end();) {
-        if (_dogSprite.getGlobalBounds().intersects(it->getGlobalBounds())) {
+        if (item.getComponent<CCollectible>().type == CCollectible::Bone)
+            _boneCount++;
+        else
             _cookieCount++;
-            SoundPlayer::getInstance().play("collect", it->getPosition());
-            it = _cookies.erase(it);
-        }
-        else {
-            ++it;
-        }
+        SoundPlayer::getInstance().play(_collectSound, item.getComponent<CTransform>().getPosition());
+        item.destroy();
     }
 
-    for (auto& car : _cars) {
-        for (auto it = _bones.begin(); it != _bones.end();) {
-            if (car.sprite.getGlobalBounds().intersects(it->getGlobalBounds())) {
-                it = _bones.erase(it);
-            }
-            else {
-                ++it;
-            }
-        }
-
-        for (auto it = _cookies.begin(); it != _cookies.end();) {
-            if (car.sprite.getGlobalBounds().intersects(it->getGlobalBounds())) {
-                it = _cookies.erase(it);
-            }
-            else {
-                ++it;
-            }
-        }
-    }
+    // cars run over whatever pickups are left in their lane
+    _carLanes.forEachOverlap(_pickupLanes, [this](EntityId car, EntityId pickup) {
+        if (_entityManager.isActive(car))
+            _entityManager.destroyEntity(pickup);
+        });
 }
 
 void Scene_Game::sUpdateProgress() {
-    if (_dogDistance >= WIN_DISTANCE && _boneCount >= _requiredBones && _cookieCount >= _requiredCookies) {
+    if (_dogDistance >= _tuning->winDistance && _boneCount >= _tuning->requiredBones && _cookieCount >= _tuning->requiredCookies) {
         _canReachHome = true;
     }
 
-    if (_canReachHome && _dogSprite.getGlobalBounds().intersects(_homeSprite.getGlobalBounds()) && !_isVictoryAnimation) {
+    if (_canReachHome && _dogBounds.intersects(_homeBounds) && !_isVictoryAnimation) {
         startVictoryAnimation();
-        SoundPlayer::getInstance().play("win");
+        SoundPlayer::getInstance().play(_winSound);
     }
 }
 
@@ -716,25 +759,26 @@ void Scene_Game::resetGame() {
     _canReachHome = false;
     _dogDistance = 0.0f;
     _boneCount = 0;
-    _cars.clear();
-    _bones.clear();
-    _cookies.clear();
+    for (auto [e, sprite] : _entityManager.view<CSprite>())
+        e.destroy();
     _cookieCount = 0;
     _dogPosition = sf::Vector2f(640.f, 600.f);
     _dogSprite.setPosition(_dogPosition);
+    _dogPrevPosition = _dogPosition;
+    _scrolledThisTick = 0.f;
     _dogSprite.setRotation(0.0f);
 
-    _dogHealth = Assets::getInstance().getInt("DogHealth", 3);
+    _dogHealth = _tuning->dogHealth;
     _invincibilityTime = 0.0f;
     _healthIcons.clear();
 
     for (int i = 0; i < _dogHealth; i++) {
         sf::Sprite heart;
-        heart.setTexture(_heartTexture);
-        float scale = Assets::getInstance().getFloat("HeartScale", 0.05f);
+        _heartTexture->applyTo(heart);
+        float scale = _tuning->heartScale;
         heart.setScale(scale, scale);
-        sf::Vector2f basePos = Assets::getInstance().getVector("HeartBasePosition", sf::Vector2f(20.f, 20.f));
-        float spacing = Assets::getInstance().getFloat("HeartSpacing", 40.f);
+        sf::Vector2f basePos = _tuning->heartBasePosition;
+        float spacing = _tuning->heartSpacing;
         heart.setPosition(basePos.x + i * spacing, basePos.y);
         _healthIcons.push_back(heart);
     }
@@ -744,13 +788,10 @@ void Scene_Game::resetGame() {
     _isVictoryAnimation = false;
     _victoryAnimationTime = 0.0f;
     _confettiParticles.clear();
-    _confettiVelocities.clear();
-    _confettiColors.clear();
     _gameTimeScale = 1.0f;
     _screenShake = 0.0f;
     _flashOverlay.setFillColor(sf::Color(255, 0, 0, 0));
     _impactParticles.clear();
-    _particleVelocities.clear();
 
     MusicPlayer::getInstance().play("background");
 }
@@ -758,35 +799,48 @@ void Scene_Game::resetGame() {
 
 void Scene_Game::updateStatistics(sf::Time dt) {
     _statisticsUpdateTime += dt;
-    _statisticsNumFrames += 1;
     if (_statisticsUpdateTime >= sf::seconds(1.0f)) {
-        _statisticsText.setString("");
+        auto residency = [](const char* label, const Assets::ResidencyStats& stats) {
+            std::ostringstream line;
+            line << std::fixed << std::setprecision(1) << "\n" << label << ": " << stats.residentCount << " / "
+                << stats.residentBytes / 1048576.f << " MB (peak " << stats.peakBytes / 1048576.f << " MB)";
+            return line.str();
+        };
+        auto& assets = Assets::getInstance();
+
+        _statisticsText.setString(
+            "FPS: " + std::to_string(_game->getFrameRate()) +
+            "\nTicks/s: " + std::to_string(_game->getTickRate()) +
+            (_game->getSimulationSpeed() == 1 ? "" : _game->getSimulationSpeed() == 0 ? " (turbo, unlimited)"
+                : " (turbo x" + std::to_string(_game->getSimulationSpeed()) + ")") +
+            "\nDraw calls: " + std::to_string(_spriteBatch.getDrawCalls()) +
+            "\nBatched sprites: " + std::to_string(_spriteBatch.getQuadCount()) +
+            residency("Textures", assets.getTextureStats()) +
+            residency("Sounds", assets.getSoundStats()));
         _statisticsUpdateTime -= sf::seconds(1.0f);
-        _statisticsNumFrames = 0;
     }
 }
 
-void Scene_Game::keepInBounds(Entity& e) {
-    if (e.hasComponent<CCollision>()) {
-        auto cr = e.getComponent<CCollision>().radius;
-        auto& tfm = e.getComponent<CTransform>();
-        auto wbounds = _game->window().getSize();
+void Scene_Game::keepInBounds(CTransform& tfm, float cr) {
+    auto wbounds = _game->windowSize();
+    sf::Vector2f pos = tfm.getPosition();
 
-        if (tfm.pos.x < cr || tfm.pos.x >(wbounds.x - cr)) {
-            tfm.vel.x *= -1;
-            tfm.pos.x = (tfm.pos.x < cr) ? cr : wbounds.x - cr;
-        }
+    if (pos.x < cr || pos.x >(wbounds.x - cr)) {
+        tfm.vel.x *= -1;
+        pos.x = (pos.x < cr) ? cr : wbounds.x - cr;
+    }
 
-        if (tfm.pos.y < cr || tfm.pos.y >(wbounds.y - cr)) {
-            tfm.vel.y *= -1;
-            tfm.pos.y = (tfm.pos.y < cr) ? cr : wbounds.y - cr;
-        }
+    if (pos.y < cr || pos.y >(wbounds.y - cr)) {
+        tfm.vel.y *= -1;
+        pos.y = (pos.y < cr) ? cr : wbounds.y - cr;
     }
+
+    tfm.setPosition(pos);
 }
 
 
 sf::FloatRect Scene_Game::getViewBounds() {
-    sf::View view = _game->window().getView();
+    const sf::View& view = _game->view();
     return sf::FloatRect(
         view.getCenter().x - (view.getSize().x / 2.f),
         view.getCenter().y - (view.getSize().y / 2.f),
@@ -796,22 +850,20 @@ sf::FloatRect Scene_Game::getViewBounds() {
 }
 
 void Scene_Game::initHealthSystem() {
-    _heartTexture = Assets::getInstance().getTexture("heart");
-
     for (int i = 0; i < _dogHealth; i++) {
         sf::Sprite heart;
-        heart.setTexture(_heartTexture);
-        float scale = Assets::getInstance().getFloat("HeartScale", 0.05f);
+        _heartTexture->applyTo(heart);
+        float scale = _tuning->heartScale;
         heart.setScale(scale, scale);
-        sf::Vector2f basePos = Assets::getInstance().getVector("HeartBasePosition", sf::Vector2f(20.f, 20.f));
-        float spacing = Assets::getInstance().getFloat("HeartSpacing", 40.f);
+        sf::Vector2f basePos = _tuning->heartBasePosition;
+        float spacing = _tuning->heartSpacing;
         heart.setPosition(basePos.x + i * spacing, basePos.y);
         _healthIcons.push_back(heart);
     }
 
-    sf::Vector2f heartBasePos = Assets::getInstance().getVector("HeartBasePosition", sf::Vector2f(20.f, 20.f));
-    float heartScale = Assets::getInstance().getFloat("HeartScale", 0.05f);
-    float heartHeight = _heartTexture.getSize().y * heartScale;
+    sf::Vector2f heartBasePos = _tuning->heartBasePosition;
+    float heartScale = _tuning->heartScale;
+    float heartHeight = _heartTexture->getSize().y * heartScale;
     _distanceText.setPosition(heartBasePos.x, heartBasePos.y + heartHeight + 20.f); // 20px padding
 }
 
@@ -824,9 +876,40 @@ void Scene_Game::initVisualEffects() {
     _homeGlow.setFillColor(sf::Color(255, 255, 100, 0)); 
     _homeGlow.setOrigin(_homeGlow.getRadius(), _homeGlow.getRadius());
     _homeGlow.setPosition(_homeSprite.getPosition());
+
+    _confettiParticles.setAcceleration(sf::Vector2f(0.f, 200.f));
+    _confettiParticles.setFade(0.3f);
+    _confettiParticles.setWobble(2.0f, 10.0f);
+    applyTuning();
 }
 
-void Scene_Game::startHitAnimation(const Car& car) {
+
+// config.txt was edited while running, swap in the new values between frames
+void Scene_Game::sReloadTuning() {
+    auto tuning = Tuning::current();
+    if (tuning == _tuning)
+        return;
+
+    _tuning = tuning;
+    applyTuning();
+}
+
+
+// state derived from tuning values; resizing a pool drops its live particles
+void Scene_Game::applyTuning() {
+    _scheduler.setInterval(_carSpawnTimer, sf::seconds(_tuning->carSpawnInterval));
+    _scheduler.setInterval(_boneSpawnTimer, sf::seconds(_tuning->boneSpawnInterval));
+    _scheduler.setInterval(_cookieSpawnTimer, sf::seconds(_tuning->cookieSpawnInterval));
+
+    if (_impactParticles.capacity() != static_cast<size_t>(_tuning->impactParticleCapacity))
+        _impactParticles.setCapacity(_tuning->impactParticleCapacity);
+    _impactParticles.setAcceleration(sf::Vector2f(0.f, _tuning->particleGravity));
+
+    if (_confettiParticles.capacity() != static_cast<size_t>(_tuning->confettiCount))
+        _confettiParticles.setCapacity(_tuning->confettiCount);
+}
+
+void Scene_Game::startHitAnimation(const CCar& car) {
     _isHitAnimation = true;
     _hitAnimationTime = 0.0f;
 
@@ -840,31 +923,35 @@ void Scene_Game::startHitAnimation(const Car& car) {
 
     float length = std::sqrt(hitDirection.x * hitDirection.x + hitDirection.y * hitDirection.y);
     hitDirection /= length;
-    float hitForce = Assets::getInstance().getFloat("HitForce", 300.0f);
+    float hitForce = _tuning->hitForce;
     _hitVelocity = hitDirection * hitForce;
 
-    SoundPlayer::getInstance().play("hit", _dogPosition);
+    SoundPlayer::getInstance().play(_hitSound, _dogPosition);
 
-    _gameTimeScale = Assets::getInstance().getFloat("HitTimeScale", 0.5f);
+    _gameTimeScale = _tuning->hitTimeScale;
 
-    _screenShake = Assets::getInstance().getFloat("ScreenShakeIntensity", 10.0f);
+    _screenShake = _tuning->screenShakeIntensity;
 
     _flashOverlay.setFillColor(sf::Color(255, 0, 0,
-        Assets::getInstance().getInt("FlashAlpha", 180)));
-
-    int particleCount = Assets::getInstance().getInt("ImpactParticleCount", 20);
+        _tuning->flashAlpha));
+
+    // ParticleFadeRate is alpha lost per frame at 60 fps
+    int particleCount = _tuning->impactParticleCount;
+    int particleFadeRate = std::max(1, _tuning->particleFadeRate);
+    float particleLifetime = 255.0f / (particleFadeRate * 60.0f);
+    // radius, angle and speed per particle, drawn in one batch
+    _burstRandom.resize(static_cast<size_t>(std::max(0, particleCount)) * 3);
+    _effectRng.fill(_burstRandom.data(), _burstRandom.size(), 0.f, 1.f);
     for (int i = 0; i < particleCount; i++) {
-        sf::CircleShape particle;
-        particle.setRadius(2.0f + (rand() % 4));
-        particle.setFillColor(sf::Color(255, 255, 255));
-        particle.setPosition(_dogPosition);
+        const float* r = &_burstRandom[i * 3];
+        float radius = 2.0f + r[0] * 4.f;
 
-        float angle = (rand() % 360) * 3.14159f / 180.0f;
-        float speed = 100.0f + (rand() % 200);
+        float angle = r[1] * 2.f * 3.14159f;
+        float speed = 100.0f + r[2] * 200.f;
         sf::Vector2f velocity(std::cos(angle) * speed, std::sin(angle) * speed);
 
-        _impactParticles.push_back(particle);
-        _particleVelocities.push_back(velocity);
+        _impactParticles.emit(_dogPosition + sf::Vector2f(radius, radius), velocity,
+            radius * 2.0f, sf::Color::White, particleLifetime);
     }
 }
 
@@ -873,56 +960,37 @@ void Scene_Game::updateHitAnimation(sf::Time dt) {
 
     _hitAnimationTime += dt.asSeconds();
 
-    _hitVelocity.y += _particleGravity * dt.asSeconds(); 
+    _hitVelocity.y += _tuning->particleGravity * dt.asSeconds(); 
     _dogPosition += _hitVelocity * dt.asSeconds();
 
-    float rotationSpeed = Assets::getInstance().getFloat("HitRotationSpeed", 360.0f);
+    float rotationSpeed = _tuning->hitRotationSpeed;
     _hitRotation += rotationSpeed * dt.asSeconds();
     _dogSprite.setRotation(_hitRotation);
 
     _dogSprite.setPosition(_dogPosition);
 
-    float timeScaleRecoveryRate = Assets::getInstance().getFloat("TimeScaleRecoveryRate", 0.5f);
+    float timeScaleRecoveryRate = _tuning->timeScaleRecoveryRate;
     if (_gameTimeScale < 1.0f) {
         _gameTimeScale += dt.asSeconds() * timeScaleRecoveryRate;
         if (_gameTimeScale > 1.0f) _gameTimeScale = 1.0f;
     }
 
-    float shakeDecayRate = Assets::getInstance().getFloat("ShakeDecayRate", 20.0f);
+    float shakeDecayRate = _tuning->shakeDecayRate;
     if (_screenShake > 0.0f) {
         _screenShake -= dt.asSeconds() * shakeDecayRate;
         if (_screenShake < 0.0f) _screenShake = 0.0f;
     }
 
     sf::Color flashColor = _flashOverlay.getFillColor();
-    int fadeRate = Assets::getInstance().getInt("FlashFadeRate", 5);
+    int fadeRate = _tuning->flashFadeRate;
     if (flashColor.a > 0) {
         flashColor.a = std::max(0, flashColor.a - fadeRate);
         _flashOverlay.setFillColor(flashColor);
     }
 
-    for (size_t i = 0; i < _impactParticles.size(); i++) {
-        _particleVelocities[i].y += _particleGravity * dt.asSeconds();
-
-        _impactParticles[i].move(_particleVelocities[i] * dt.asSeconds());
+    _impactParticles.update(dt.asSeconds());
 
-        sf::Color color = _impactParticles[i].getFillColor();
-        int particleFadeRate = Assets::getInstance().getInt("ParticleFadeRate", 2);
-        color.a = std::max(0, color.a - particleFadeRate);
-        _impactParticles[i].setFillColor(color);
-    }
-
-    for (size_t i = 0; i < _impactParticles.size();) {
-        if (_impactParticles[i].getFillColor().a == 0) {
-            _impactParticles.erase(_impactParticles.begin() + i);
-            _particleVelocities.erase(_particleVelocities.begin() + i);
-        }
-        else {
-            i++;
-        }
-    }
-
-    if (_hitAnimationTime >= _hitAnimationDuration) {
+    if (_hitAnimationTime >= _tuning->hitAnimationDuration) {
         _isHitAnimation = false;
         _dogSprite.setRotation(0.0f); 
         _gameTimeScale = 1.0f; 
@@ -939,33 +1007,32 @@ void Scene_Game::startVictoryAnimation() {
     _isVictoryAnimation = true;
     _victoryAnimationTime = 0.0f;
 
-    int confettiCount = 200;
-    for (int i = 0; i < confettiCount; i++) {
-        sf::CircleShape confetti;
-        confetti.setRadius(3.0f + (rand() % 5));
+    // radius, colour, angle, distance and velocity per particle, drawn in one batch
+    _burstRandom.resize(_confettiParticles.capacity() * 6);
+    _effectRng.fill(_burstRandom.data(), _burstRandom.size(), 0.f, 1.f);
+    for (size_t i = 0; i < _confettiParticles.capacity(); i++) {
+        const float* r = &_burstRandom[i * 6];
+        float radius = 3.0f + r[0] * 5.f;
 
         sf::Color color;
-        switch (rand() % 5) {
+        switch (static_cast<int>(r[1] * 5.f)) {
         case 0: color = sf::Color::Red; break;
         case 1: color = sf::Color::Blue; break;
         case 2: color = sf::Color::Green; break;
         case 3: color = sf::Color::Yellow; break;
         case 4: color = sf::Color::Magenta; break;
         }
-        confetti.setFillColor(color);
 
-        float angle = (rand() % 360) * 3.14159f / 180.0f;
-        float distance = 10.0f + (rand() % 20);
+        float angle = r[2] * 2.f * 3.14159f;
+        float distance = 10.0f + r[3] * 20.f;
         sf::Vector2f offset(std::cos(angle) * distance, std::sin(angle) * distance);
-        confetti.setPosition(_homeSprite.getPosition() + offset);
 
-        float xVel = -100.0f + (rand() % 200);
-        float yVel = -300.0f - (rand() % 200); 
+        float xVel = -100.0f + r[4] * 200.f;
+        float yVel = -300.0f - r[5] * 200.f;
         sf::Vector2f velocity(xVel, yVel);
 
-        _confettiParticles.push_back(confetti);
-        _confettiVelocities.push_back(velocity);
-        _confettiColors.push_back(color);
+        _confettiParticles.emit(_homeSprite.getPosition() + offset + sf::Vector2f(radius, radius), velocity,
+            radius * 2.0f, color, _victoryAnimationDuration);
     }
 
 }
@@ -980,49 +1047,37 @@ void Scene_Game::updateVictoryAnimation(sf::Time dt) {
 
     if (length > 5.0f) { 
         homeDirection /= length; 
-        _dogPosition += homeDirection * _dogSpeed * 0.5f * dt.asSeconds();
+        _dogPosition += homeDirection * _tuning->dogSpeed * 0.5f * dt.asSeconds();
         _dogSprite.setPosition(_dogPosition);
 
         if (homeDirection.x < 0) {
-            _dogSprite.setTextureRect(sf::IntRect(_dogAnimationFrame * 32, 32, 32, 32)); // Left
+            _dogSprite.setTextureRect(_dogTexture->subRect(sf::IntRect(_dogAnimationFrame * 32, 32, 32, 32))); // Left
         }
         else if (homeDirection.x > 0) {
-            _dogSprite.setTextureRect(sf::IntRect(_dogAnimationFrame * 32, 64, 32, 32)); // Right
+            _dogSprite.setTextureRect(_dogTexture->subRect(sf::IntRect(_dogAnimationFrame * 32, 64, 32, 32))); // Right
         }
         else if (homeDirection.y < 0) {
-            _dogSprite.setTextureRect(sf::IntRect(_dogAnimationFrame * 32, 96, 32, 32)); // Up
+            _dogSprite.setTextureRect(_dogTexture->subRect(sf::IntRect(_dogAnimationFrame * 32, 96, 32, 32))); // Up
         }
         else {
-            _dogSprite.setTextureRect(sf::IntRect(_dogAnimationFrame * 32, 0, 32, 32)); // Down
+            _dogSprite.setTextureRect(_dogTexture->subRect(sf::IntRect(_dogAnimationFrame * 32, 0, 32, 32))); // Down
         }
 
-        if (_animationClock.getElapsedTime().asSeconds() > 0.1f) {
+        if (_animationFrameDue) {
             _dogAnimationFrame = (_dogAnimationFrame + 1) % 3;
-            _animationClock.restart();
+            nextAnimationFrame();
         }
     }
     else {
-        if (_animationClock.getElapsedTime().asSeconds() > 0.1f) {
+        if (_animationFrameDue) {
             _dogAnimationFrame = (_dogAnimationFrame + 1) % 3;
-            _dogSprite.setTextureRect(sf::IntRect(_dogAnimationFrame * 32, 64, 32, 32)); // Right-facing frames
-            _animationClock.restart();
+            _dogSprite.setTextureRect(_dogTexture->subRect(sf::IntRect(_dogAnimationFrame * 32, 64, 32, 32))); // Right-facing frames
+            nextAnimationFrame();
         }
     }
 
-    for (size_t i = 0; i < _confettiParticles.size(); i++) {
-        _confettiVelocities[i].y += 200.0f * dt.asSeconds();
-
-        _confettiParticles[i].move(_confettiVelocities[i] * dt.asSeconds());
-
-        float wobble = std::sin(_victoryAnimationTime * 10.0f + i) * 2.0f;
-        _confettiParticles[i].move(wobble * dt.asSeconds(), 0);
-
-        if (_victoryAnimationTime > _victoryAnimationDuration * 0.7f) {
-            sf::Color color = _confettiColors[i];
-            color.a = static_cast<sf::Uint8>(255 * (1.0f - (_victoryAnimationTime - _victoryAnimationDuration * 0.7f) / (_victoryAnimationDuration * 0.3f)));
-            _confettiParticles[i].setFillColor(color);
-        }
-    }
+    // fades over the last 30% of the animation, see initVisualEffects
+    _confettiParticles.update(dt.asSeconds());
 
     float pulseRate = 3.0f; 
     _homeGlowValue = (std::sin(_victoryAnimationTime * pulseRate * 2 * 3.14159f) + 1.0f) / 2.0f;
@@ -4,65 +4,70 @@
 #include "EntityManager.h"
 #include "Entity.h"
 #include "BackgroundScene.h"
+#include "LaneSweep.h"
+#include "SpriteBatch.h"
+#include "ParticleEmitter.h"
+#include "Tuning.h"
+#include "Random.h"
+#include "Scheduler.h"
 #include <SFML/Audio.hpp>
 #include <vector>
 
-struct Car {
-    sf::Sprite sprite;
-    bool goingDown = true;
-};
-
 class Scene_Game : public Scene {
 private:
     GameEngine* _game;
     BackgroundScene _backgroundScene;
     EntityManager _entityManager;
+    TagId _carTag;
+    TagId _boneTag;
+    TagId _cookieTag;
+
+    // Broad phase
+    LaneSweep _carLanes;
+    LaneSweep _pickupLanes;
+    std::vector<EntityId> _broadPhaseHits;
 
     // Game objects
-    sf::Texture _backgroundTexture;
+    TextureRef _backgroundTexture;
     sf::Sprite _backgroundSprite1;
     sf::Sprite _backgroundSprite2;
-    sf::Texture _roadTexture;
+    TextureRef _roadTexture;
     sf::Sprite _roadSprite1;
     sf::Sprite _roadSprite2;
-    sf::Texture _dogTexture;
+    TextureRef _dogTexture;
     sf::Sprite _dogSprite;
+    sf::FloatRect _dogBounds;     // refreshed once per tick after movement
     sf::Vector2f _dogPosition;
-    sf::Texture _carSheetTexture;
+    sf::Vector2f _dogPrevPosition;      // sprite position at the start of the tick
+    float _scrolledThisTick{ 0.f };     // backdrop scroll since then
+    TextureRef _carSheetTexture;
     std::vector<sf::IntRect> _carFrames;
-    std::vector<Car> _cars;
-    sf::Texture _boneTexture;
-    std::vector<sf::Sprite> _bones;
-    sf::Texture _homeTexture;
+    TextureRef _boneTexture;
+    TextureRef _homeTexture;
     sf::Sprite _homeSprite;
-    sf::Texture _gameOverTexture;
+    sf::FloatRect _homeBounds;
+    TextureRef _gameOverTexture;
     sf::Sprite _gameOverSprite;
-    sf::Texture _winTexture;
+    TextureRef _winTexture;
     sf::Sprite _winSprite;
 
-    float _leftBoundary;
+    // Sound effects, resolved once
+    SoundId _hitSound;
+    SoundId _collectSound;
+    SoundId _winSound;
 
     // Cookie-related variables
-    sf::Texture _cookieTexture;
-    std::vector<sf::Sprite> _cookies;
+    TextureRef _cookieTexture;
     int _cookieCount = 0;
-    sf::Clock _cookieSpawnClock;
-    float _cookieSpawnInterval;
-    int _requiredCookies;
 
 
     // UI elements
     sf::Text _statisticsText;
+    bool _showStatistics = false;
     sf::Text _distanceText;
 
-    // Game parameters
-    float _dogSpeed;
-    float _carSpeed;
-    float _backgroundScrollSpeed;
-    float _spawnInterval;
-    float _boneSpawnInterval;
-    int _requiredBones;
-    float WIN_DISTANCE;
+    // Game parameters, resolved from config.txt once
+    std::shared_ptr<const Tuning> _tuning;
 
     // Game state
     bool _isGameOver;
@@ -73,17 +78,28 @@ private:
     int _boneCount;
     int _dogAnimationFrame;
 
-    // Clocks
-    sf::Clock _carSpawnClock;
-    sf::Clock _boneSpawnClock;
-    sf::Clock _animationClock;
+    // Separate streams, so effects and frame-rate dependent rendering never
+    // shift the spawn sequence a seed produces
+    std::uint64_t _seed;
+    Rng _spawnRng;
+    Rng _effectRng;
+    Rng _renderRng;
+    std::vector<float> _burstRandom;
+
+    // Spawning and sprite frames run on game time, see initTimers
+    Scheduler _scheduler;
+    Scheduler::TimerId _carSpawnTimer;
+    Scheduler::TimerId _boneSpawnTimer;
+    Scheduler::TimerId _cookieSpawnTimer;
+    Scheduler::TimerId _animationTimer;
+    bool _animationFrameDue = false;
     sf::Time _statisticsUpdateTime;
-    unsigned int _statisticsNumFrames;
+
+    SpriteBatch _spriteBatch;
 
     // Hit animation
     bool _isHitAnimation = false;
     float _hitAnimationTime = 0.0f;
-    float _hitAnimationDuration = 2.0f;
     sf::Vector2f _hitVelocity;
     float _hitRotation = 0.0f;
     float _gameTimeScale = 1.0f;
@@ -94,24 +110,19 @@ private:
     bool _isVictoryAnimation = false;
     float _victoryAnimationTime = 0.0f;
     float _victoryAnimationDuration = 3.0f; 
-    std::vector<sf::CircleShape> _confettiParticles;
-    std::vector<sf::Vector2f> _confettiVelocities;
-    std::vector<sf::Color> _confettiColors;
+    ParticleEmitter _confettiParticles;
     float _homeGlowValue = 0.0f;
     sf::CircleShape _homeGlow;
 
     // Health system
     int _dogHealth = 3;
     float _invincibilityTime = 0.0f;
-    float _invincibilityDuration = 2.0f;
     std::vector<sf::Sprite> _healthIcons;
-    sf::Texture _heartTexture;
+    TextureRef _heartTexture;
 
     // Visual effects
     sf::RectangleShape _flashOverlay;
-    std::vector<sf::CircleShape> _impactParticles;
-    std::vector<sf::Vector2f> _particleVelocities;
-    float _particleGravity = 200.0f;
+    ParticleEmitter _impactParticles;
 
 
     // Systems
@@ -120,14 +131,15 @@ private:
     void sScrollBackground(sf::Time dt);
     void sCollision();
     void sUserInput(const sf::Event& event);
-    void sSpawnObjects(sf::Time dt);
     void spawnBone();
     void spawnCookie();
     void spawnCar();
-    void sObjectMovement(sf::Time dt);
+    void sCulling();
+    void sBroadPhase();
     void sCollectibles();
     void sUpdateProgress();
     void initActionMap();
+    void initEntityTags();
     void initTextures();
     void initUI();
     void initGameParameters();
@@ -135,28 +147,24 @@ private:
     void initCarFrames();
     void initHomeAndGameStates();
     void initGameState();
-    void initClocks();
+    void initTimers();
+    void nextAnimationFrame();
 
     // Helper methods
     void resetGame();
     void updateStatistics(sf::Time dt);
-    void keepInBounds(Entity& e);
+    void sReloadTuning();
+    void applyTuning();
+    void keepInBounds(CTransform& tfm, float radius);
     sf::FloatRect getViewBounds();
     void adjustPlayerPosition();
 
-    bool areSpritesTooClose(const sf::Sprite& sprite1, const sf::Sprite& sprite2, float minDistance = 50.0f) {
-        sf::Vector2f pos1 = sprite1.getPosition();
-        sf::Vector2f pos2 = sprite2.getPosition();
-        float distance = std::sqrt(std::pow(pos1.x - pos2.x, 2) + std::pow(pos1.y - pos2.y, 2));
-        return distance < minDistance;
-    }
-
 
     // Methods for hit animation
     void initSounds();
     void initHealthSystem();
     void initVisualEffects();
-    void startHitAnimation(const Car& car);
+    void startHitAnimation(const CCar& car);
     void updateHitAnimation(sf::Time dt);
     void startVictoryAnimation();
     void updateVictoryAnimation(sf::Time dt);
@@ -169,6 +177,12 @@ public:
     void update(sf::Time dt) override;
     void sRender() override;
     void doAction(const Command& command) override;
+    void beginTick() override;
+    bool hasEnded() const override { return _isGameOver || _isWin; }
+
+    bool isWin() const { return _isWin; }
+    std::uint64_t getSeed() const { return _seed; }
+    float getDistance() const { return _dogDistance; }
 
     // Event handlers
     void handlePlayerMovement(const sf::Vector2f& direction);
@@ -0,0 +1,57 @@
+#include "Scene_Loading.h"
+#include "Scene_Title.h"
+#include "Assets.h"
+
+Scene_Loading::Scene_Loading(GameEngine* game) : _game(game) {
+    _actionMap[sf::Keyboard::Escape] = "EXIT";
+
+    // fonts are loaded synchronously, so this one is already there
+    _loadingText.setFont(Assets::getInstance().getFont("main"));
+    _loadingText.setCharacterSize(30);
+    _loadingText.setFillColor(sf::Color::White);
+
+    _progressSize = sf::Vector2f(_game->windowSize().x * 0.5f, 24.f);
+    sf::Vector2f barPosition(
+        (_game->windowSize().x - _progressSize.x) / 2.0f,
+        _game->windowSize().y / 2.0f
+    );
+
+    _progressFrame.setSize(_progressSize);
+    _progressFrame.setPosition(barPosition);
+    _progressFrame.setFillColor(sf::Color::Transparent);
+    _progressFrame.setOutlineColor(sf::Color::White);
+    _progressFrame.setOutlineThickness(2.f);
+
+    _progressBar.setSize(sf::Vector2f(0.f, _progressSize.y));
+    _progressBar.setPosition(barPosition);
+    _progressBar.setFillColor(sf::Color::White);
+}
+
+void Scene_Loading::update(sf::Time dt) {
+    // GameEngine::run drives Assets::update
+    auto& assets = Assets::getInstance();
+
+    float progress = assets.getLoadProgress();
+    _progressBar.setSize(sf::Vector2f(_progressSize.x * progress, _progressSize.y));
+    _loadingText.setString("Loading... " + std::to_string(static_cast<int>(progress * 100.f)) + "%");
+
+    sf::FloatRect textBounds = _loadingText.getLocalBounds();
+    _loadingText.setOrigin(textBounds.width / 2.0f, textBounds.height);
+    _loadingText.setPosition(_game->windowSize().x / 2.0f, _progressFrame.getPosition().y - 20.f);
+
+    if (assets.isLoaded()) {
+        _game->changeScene("TITLE", std::make_shared<Scene_Title>(_game), true);
+    }
+}
+
+void Scene_Loading::sRender() {
+    _game->window().draw(_loadingText);
+    _game->window().draw(_progressFrame);
+    _game->window().draw(_progressBar);
+}
+
+void Scene_Loading::doAction(const Command& command) {
+    if (command.getName() == "EXIT" && command.getType() == "START") {
+        _game->quit();
+    }
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include "Scene.h"
+#include "GameEngine.h"
+
+// First scene: drives Assets::update until everything is loaded, then moves on to the title.
+class Scene_Loading : public Scene {
+private:
+    GameEngine* _game;
+    sf::Text _loadingText;
+    sf::RectangleShape _progressFrame;
+    sf::RectangleShape _progressBar;
+    sf::Vector2f _progressSize;
+
+public:
+    Scene_Loading(GameEngine* game);
+    void update(sf::Time dt) override;
+    void sRender() override;
+    void doAction(const Command& command) override;
+};
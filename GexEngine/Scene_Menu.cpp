@@ -9,11 +9,12 @@ Scene_Menu::Scene_Menu(GameEngine* game) : _game(game) {
     _actionMap[sf::Keyboard::Enter] = "SELECT";
     _actionMap[sf::Keyboard::Escape] = "BACK";
 
-    _menuTexture = Assets::getInstance().getTexture("menu");
-    _menuSprite.setTexture(_menuTexture);
+    _menuTexture = TextureRef("menu");
+    const TextureRegion& menuRegion = *_menuTexture;
+    menuRegion.applyTo(_menuSprite);
     _menuSprite.setScale(
-        _game->windowSize().x / _menuTexture.getSize().x,
-        _game->windowSize().y / _menuTexture.getSize().y
+        _game->windowSize().x / menuRegion.getSize().x,
+        _game->windowSize().y / menuRegion.getSize().y
     );
 
     _highlightRect.setSize(sf::Vector2f(400, 70));
@@ -20,7 +20,7 @@ enum class MenuState {
 class Scene_Menu : public Scene {
 private:
     GameEngine* _game;
-    sf::Texture _menuTexture;
+    TextureRef _menuTexture;
     sf::Sprite _menuSprite;
 
     MenuOption _currentOption = MenuOption::START_GAME;
@@ -9,11 +9,12 @@ Scene_Title::Scene_Title(GameEngine* game) : _game(game) {
 
     std::string assetsPath = "../assets/";
 
-    _titleTexture = Assets::getInstance().getTexture("title");
-    _titleSprite.setTexture(_titleTexture);
+    _titleTexture = TextureRef("title");
+    const TextureRegion& titleRegion = *_titleTexture;
+    titleRegion.applyTo(_titleSprite);
     _titleSprite.setScale(
-        _game->windowSize().x / _titleTexture.getSize().x,
-        _game->windowSize().y / _titleTexture.getSize().y
+        _game->windowSize().x / titleRegion.getSize().x,
+        _game->windowSize().y / titleRegion.getSize().y
     );
 }
 
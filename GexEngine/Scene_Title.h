@@ -5,7 +5,7 @@
 class Scene_Title : public Scene {
 private:
     GameEngine* _game;
-    sf::Texture _titleTexture;
+    TextureRef _titleTexture;
     sf::Sprite _titleSprite;
     sf::Clock _animationClock;
 
@@ -0,0 +1,126 @@
+#include "Scheduler.h"
+#include <algorithm>
+
+Scheduler::TimerId Scheduler::every(sf::Time interval, std::function<void()> callback) {
+    return add(interval, std::move(callback), true);
+}
+
+
+Scheduler::TimerId Scheduler::after(sf::Time delay, std::function<void()> callback) {
+    return add(delay, std::move(callback), false);
+}
+
+
+Scheduler::TimerId Scheduler::add(sf::Time interval, std::function<void()> callback, bool repeat) {
+    std::uint32_t index;
+    if (!m_free.empty()) {
+        index = m_free.back();
+        m_free.pop_back();
+    }
+    else {
+        index = static_cast<std::uint32_t>(m_timers.size());
+        m_timers.emplace_back();
+    }
+
+    Timer& timer = m_timers[index];
+    timer.callback = std::move(callback);
+    // a repeating timer must move time forward or advance() never returns
+    timer.interval = std::max<sf::Int64>(interval.asMicroseconds(), repeat ? 1 : 0);
+    timer.active = true;
+    timer.repeat = repeat;
+    arm(index, m_now);
+    return TimerId{ index, timer.generation };
+}
+
+
+void Scheduler::arm(std::uint32_t index, sf::Int64 from) {
+    Timer& timer = m_timers[index];
+    timer.armedAt = from;
+    m_queue.push(Due{ from + timer.interval, m_order++, index, ++timer.arming });
+}
+
+
+Scheduler::Timer* Scheduler::find(TimerId id) {
+    if (id.index >= m_timers.size())
+        return nullptr;
+    Timer& timer = m_timers[id.index];
+    return timer.active && timer.generation == id.generation ? &timer : nullptr;
+}
+
+
+void Scheduler::cancel(TimerId id) {
+    if (Timer* timer = find(id)) {
+        timer->active = false;
+        timer->callback = nullptr;
+        ++timer->generation;
+        m_free.push_back(id.index);
+    }
+}
+
+
+void Scheduler::restart(TimerId id) {
+    // the old queue entry goes stale, the id stays valid
+    if (find(id))
+        arm(id.index, m_now);
+}
+
+
+void Scheduler::setInterval(TimerId id, sf::Time interval) {
+    if (Timer* timer = find(id)) {
+        timer->interval = std::max<sf::Int64>(interval.asMicroseconds(), timer->repeat ? 1 : 0);
+        arm(id.index, timer->armedAt);
+    }
+}
+
+
+bool Scheduler::isActive(TimerId id) const {
+    return id.index < m_timers.size() && m_timers[id.index].active
+        && m_timers[id.index].generation == id.generation;
+}
+
+
+// callbacks see now() at their own deadline, so timers they arm or restart
+// count from when they fired, not from the end of a long step
+void Scheduler::advance(sf::Time dt) {
+    const sf::Int64 target = m_now + std::max<sf::Int64>(dt.asMicroseconds(), 0);
+
+    while (!m_queue.empty() && m_queue.top().deadline <= target) {
+        Due due = m_queue.top();
+        m_queue.pop();
+        m_now = std::max(m_now, due.deadline);
+
+        Timer& timer = m_timers[due.index];
+        if (!timer.active || timer.arming != due.arming)
+            continue;
+
+        if (timer.repeat) {
+            arm(due.index, due.deadline);
+        }
+        else {
+            timer.active = false;
+            ++timer.generation;
+            m_free.push_back(due.index);
+        }
+
+        // the callback may add or cancel timers, which can move m_timers
+        auto callback = timer.repeat ? timer.callback : std::move(timer.callback);
+        callback();
+    }
+    m_now = target;
+}
+
+
+// slots are kept with their generation bumped, so no old id matches a new timer
+void Scheduler::clear() {
+    m_free.clear();
+    for (std::uint32_t i = 0; i < m_timers.size(); ++i) {
+        Timer& timer = m_timers[i];
+        if (timer.active)
+            ++timer.generation;
+        timer.active = false;
+        timer.callback = nullptr;
+        m_free.push_back(i);
+    }
+    m_queue = {};
+    m_now = 0;
+}
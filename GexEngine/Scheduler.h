@@ -0,0 +1,75 @@
+#pragma once
+#include <SFML/System/Time.hpp>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+// Timers on simulation time. advance() is fed the dt the owning scene's
+// update gets, so timers follow slow motion and pause and fire the same way
+// at any tick rate, headless or in a replay. Time is counted in whole
+// microseconds, which adds up identically on every run.
+class Scheduler {
+public:
+    struct TimerId {
+        static constexpr std::uint32_t Invalid = 0xFFFFFFFFu;
+
+        std::uint32_t index{ Invalid };
+        std::uint32_t generation{ 0 };
+
+        bool isValid() const { return index != Invalid; }
+    };
+
+private:
+    struct Timer {
+        std::function<void()>   callback;
+        sf::Int64               interval{ 0 };
+        sf::Int64               armedAt{ 0 };
+        std::uint32_t           generation{ 0 };    // bumped when the slot is freed
+        std::uint32_t           arming{ 0 };        // bumped whenever it is (re)queued
+        bool                    active{ false };
+        bool                    repeat{ false };
+    };
+
+    // queue entries go stale when their timer is cancelled or re-armed,
+    // they are skipped when they come up instead of being searched for
+    struct Due {
+        sf::Int64               deadline;
+        std::uint64_t           order;          // ties fire in arming order
+        std::uint32_t           index;
+        std::uint32_t           arming;
+    };
+
+    struct Later {
+        bool operator()(const Due& a, const Due& b) const {
+            return a.deadline != b.deadline ? a.deadline > b.deadline : a.order > b.order;
+        }
+    };
+
+    std::vector<Timer>                              m_timers;
+    std::vector<std::uint32_t>                      m_free;
+    std::priority_queue<Due, std::vector<Due>, Later> m_queue;
+    sf::Int64                                       m_now{ 0 };
+    std::uint64_t                                   m_order{ 0 };
+
+    TimerId add(sf::Time interval, std::function<void()> callback, bool repeat);
+    void arm(std::uint32_t index, sf::Int64 from);
+    Timer* find(TimerId id);
+
+public:
+    // every interval from now on, catching up with several calls when one
+    // advance covers more than an interval
+    TimerId every(sf::Time interval, std::function<void()> callback);
+    TimerId after(sf::Time delay, std::function<void()> callback);
+
+    // unknown and finished ids are ignored
+    void cancel(TimerId id);
+    void restart(TimerId id);                           // next firing a full interval from now
+    void setInterval(TimerId id, sf::Time interval);    // counts from when the timer was last armed
+    bool isActive(TimerId id) const;
+
+    void advance(sf::Time dt);
+    void clear();
+
+    sf::Time now() const { return sf::microseconds(m_now); }
+};
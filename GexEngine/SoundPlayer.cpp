@@ -11,8 +11,9 @@ namespace {
     const float MinDistance3D = std::sqrt(MinDistance2D * MinDistance2D + ListenerZ * ListenerZ);
 }
 
+// the listener already faces (0, 0, -1), the player touches it only once
+// enabled so that headless runs never open the audio device
 SoundPlayer::SoundPlayer() {
-    sf::Listener::setDirection(0.f, 0.f, -1.f);
 }
 
 SoundPlayer& SoundPlayer::getInstance() {
@@ -25,10 +26,22 @@ void SoundPlayer::play(String effect) {
 }
 
 void SoundPlayer::play(String effect, sf::Vector2f position) {
-    m_sounds.push_back(sf::Sound());
-    sf::Sound& sound = m_sounds.back();
+    play(Assets::getInstance().soundId(effect), position);
+}
+
+void SoundPlayer::play(SoundId effect) {
+    play(effect, getListnerPosition());
+}
 
-    sound.setBuffer(Assets::getInstance().getSoundBuffer(effect));
+void SoundPlayer::play(SoundId effect, sf::Vector2f position) {
+    if (!m_enabled)
+        return;
+
+    m_sounds.push_back(PlayingSound{ SoundRef(effect), sf::Sound() });
+    PlayingSound& playing = m_sounds.back();
+    sf::Sound& sound = playing.sound;
+
+    sound.setBuffer(*playing.buffer);
     sound.setPosition(position.x, 0.f, -position.y);
     sound.setAttenuation(Attenuation);
     sound.setMinDistance(MinDistance3D);
@@ -36,20 +49,26 @@ void SoundPlayer::play(String effect, sf::Vector2f position) {
 }
 
 void SoundPlayer::removeStoppedSounds() {
-    m_sounds.remove_if([](const sf::Sound& s) {
-        return s.getStatus() == sf::Sound::Stopped;
+    m_sounds.remove_if([](const PlayingSound& s) {
+        return s.sound.getStatus() == sf::Sound::Stopped;
         });
 }
 
 void SoundPlayer::setListnerPosition(sf::Vector2f position) {
+    if (!m_enabled)
+        return;
     sf::Listener::setPosition(position.x, -position.y, ListenerZ);
 }
 
 void SoundPlayer::setListnerDirection(sf::Vector2f position) {
+    if (!m_enabled)
+        return;
     sf::Listener::setDirection(position.x, 0, -position.y);
 }
 
 sf::Vector2f SoundPlayer::getListnerPosition() const {
+    if (!m_enabled)
+        return sf::Vector2f();
     sf::Vector3f pos = sf::Listener::getPosition();
     return sf::Vector2f(pos.x, -pos.y);
 }
@@ -57,3 +76,9 @@ sf::Vector2f SoundPlayer::getListnerPosition() const {
 bool SoundPlayer::isEmpty() const {
     return m_sounds.empty();
 }
+
+void SoundPlayer::setEnabled(bool enabled) {
+    m_enabled = enabled;
+    if (!m_enabled)
+        m_sounds.clear();
+}
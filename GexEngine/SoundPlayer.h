@@ -1,5 +1,6 @@
 #pragma once
 #include <SFML/Audio.hpp>
+#include "Assets.h"
 #include <list>
 #include <string>
 
@@ -7,7 +8,14 @@ using String = std::string;
 
 class SoundPlayer {
 private:
-    std::list<sf::Sound> m_sounds;
+    // the reference keeps the buffer resident until the sound is done
+    struct PlayingSound {
+        SoundRef    buffer;
+        sf::Sound   sound;
+    };
+
+    std::list<PlayingSound> m_sounds;
+    bool                    m_enabled{ true };
 
     SoundPlayer();
 
@@ -19,9 +27,14 @@ public:
 
     void play(String effect);
     void play(String effect, sf::Vector2f position);
+    void play(SoundId effect);
+    void play(SoundId effect, sf::Vector2f position);
     void removeStoppedSounds();
     void setListnerPosition(sf::Vector2f position);
     void setListnerDirection(sf::Vector2f position);
     sf::Vector2f getListnerPosition() const;
     bool isEmpty() const;
+
+    // disabled players ignore play(), for headless runs without an audio device
+    void setEnabled(bool enabled);
 };
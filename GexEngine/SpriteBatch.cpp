@@ -0,0 +1,85 @@
+#include "SpriteBatch.h"
+#include <algorithm>
+#include <cmath>
+
+void SpriteBatch::beginFrame() {
+    _lastFrameDrawCalls = _drawCalls;
+    _lastFrameQuads = _quads;
+    _drawCalls = 0;
+    _quads = 0;
+}
+
+SpriteBatch::Batch& SpriteBatch::batchFor(const sf::Texture* texture, int layer) {
+    // consecutive sprites usually share a batch
+    if (_lastBatch < _batches.size()
+        && _batches[_lastBatch].texture == texture && _batches[_lastBatch].layer == layer)
+        return _batches[_lastBatch];
+
+    for (size_t i = 0; i < _batches.size(); ++i) {
+        if (_batches[i].texture == texture && _batches[i].layer == layer) {
+            _lastBatch = i;
+            return _batches[i];
+        }
+    }
+
+    _batches.push_back(Batch{ layer, texture });
+    _lastBatch = _batches.size() - 1;
+    return _batches.back();
+}
+
+void SpriteBatch::draw(const sf::Sprite& sprite, int layer) {
+    if (sprite.getTexture())
+        draw(*sprite.getTexture(), sprite.getTextureRect(), sprite.getTransform(), sprite.getColor(), layer);
+}
+
+void SpriteBatch::draw(const sf::Texture& texture, const sf::IntRect& rect,
+    const sf::Transform& transform, const sf::Color& color, int layer) {
+    float width = static_cast<float>(std::abs(rect.width));
+    float height = static_cast<float>(std::abs(rect.height));
+
+    float u0 = static_cast<float>(rect.left);
+    float v0 = static_cast<float>(rect.top);
+    float u1 = u0 + static_cast<float>(rect.width);
+    float v1 = v0 + static_cast<float>(rect.height);
+
+    sf::Vertex topLeft(transform.transformPoint(0.f, 0.f), color, sf::Vector2f(u0, v0));
+    sf::Vertex topRight(transform.transformPoint(width, 0.f), color, sf::Vector2f(u1, v0));
+    sf::Vertex bottomRight(transform.transformPoint(width, height), color, sf::Vector2f(u1, v1));
+    sf::Vertex bottomLeft(transform.transformPoint(0.f, height), color, sf::Vector2f(u0, v1));
+
+    auto& vertices = batchFor(&texture, layer).vertices;
+    vertices.append(topLeft);
+    vertices.append(topRight);
+    vertices.append(bottomRight);
+    vertices.append(topLeft);
+    vertices.append(bottomRight);
+    vertices.append(bottomLeft);
+    ++_quads;
+}
+
+void SpriteBatch::drawImmediate(sf::RenderTarget& target, const sf::Drawable& drawable,
+    const sf::RenderStates& states) {
+    flush(target);
+    target.draw(drawable, states);
+    ++_drawCalls;
+}
+
+void SpriteBatch::flush(sf::RenderTarget& target) {
+    _order.clear();
+    for (size_t i = 0; i < _batches.size(); ++i) {
+        if (_batches[i].vertices.getVertexCount() > 0)
+            _order.push_back(i);
+    }
+
+    std::sort(_order.begin(), _order.end(), [this](size_t a, size_t b) {
+        if (_batches[a].layer != _batches[b].layer)
+            return _batches[a].layer < _batches[b].layer;
+        return std::less<const sf::Texture*>()(_batches[a].texture, _batches[b].texture);
+        });
+
+    for (auto i : _order) {
+        target.draw(_batches[i].vertices, sf::RenderStates(_batches[i].texture));
+        _batches[i].vertices.clear();
+        ++_drawCalls;
+    }
+}
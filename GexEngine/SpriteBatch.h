@@ -0,0 +1,41 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Collects textured quads into one sf::VertexArray per (layer, texture) and
+// draws each array with a single call, lowest layer first. Anything that
+// can't be batched goes through drawImmediate, which flushes the queued
+// quads first so painter's order is kept.
+class SpriteBatch {
+private:
+    struct Batch {
+        int                 layer;
+        const sf::Texture*  texture;
+        sf::VertexArray     vertices{ sf::Triangles };
+    };
+
+    std::vector<Batch>  _batches;       // kept between frames to reuse their storage
+    std::vector<size_t> _order;
+    size_t              _lastBatch{ 0 };
+    unsigned int        _drawCalls{ 0 };
+    unsigned int        _lastFrameDrawCalls{ 0 };
+    unsigned int        _quads{ 0 };
+    unsigned int        _lastFrameQuads{ 0 };
+
+    Batch& batchFor(const sf::Texture* texture, int layer);
+
+public:
+    void beginFrame();
+
+    void draw(const sf::Sprite& sprite, int layer = 0);
+    void draw(const sf::Texture& texture, const sf::IntRect& rect,
+        const sf::Transform& transform, const sf::Color& color = sf::Color::White, int layer = 0);
+
+    void drawImmediate(sf::RenderTarget& target, const sf::Drawable& drawable,
+        const sf::RenderStates& states = sf::RenderStates::Default);
+    void flush(sf::RenderTarget& target);
+
+    // totals of the last completed frame
+    unsigned int getDrawCalls() const { return _lastFrameDrawCalls; }
+    unsigned int getQuadCount() const { return _lastFrameQuads; }
+};
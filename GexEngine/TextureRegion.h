@@ -0,0 +1,26 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+// Where a named texture lives: either a whole standalone texture or a
+// sub-rect of a shared atlas page. Texture rects used by sprites must be
+// offset into the region, see subRect.
+struct TextureRegion {
+    const sf::Texture*  texture{ nullptr };
+    sf::IntRect         rect;
+
+    sf::Vector2u getSize() const {
+        return sf::Vector2u(static_cast<unsigned>(rect.width), static_cast<unsigned>(rect.height));
+    }
+
+    // local is relative to the original image
+    sf::IntRect subRect(const sf::IntRect& local) const {
+        return sf::IntRect(rect.left + local.left, rect.top + local.top, local.width, local.height);
+    }
+
+    // headless regions have no texture, the rect still sizes the sprite
+    void applyTo(sf::Sprite& sprite) const {
+        if (texture)
+            sprite.setTexture(*texture);
+        sprite.setTextureRect(rect);
+    }
+};
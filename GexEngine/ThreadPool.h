@@ -0,0 +1,49 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed set of worker threads pulling tasks off one queue. Work is handed in
+// through submit, which returns a future for the task's result. Destruction
+// finishes whatever is still queued and joins the workers.
+class ThreadPool {
+private:
+    std::vector<std::thread>            m_workers;
+    std::queue<std::function<void()>>   m_tasks;
+    std::mutex                          m_mutex;
+    std::condition_variable             m_wake;
+    bool                                m_stopping{ false };
+
+    void workerLoop();
+
+public:
+    // 0 picks one thread less than the hardware has, leaving a core to the render thread
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template<typename F>
+    auto submit(F&& task) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+
+        // std::function needs a copyable target, packaged_task is move-only
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        auto future = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.emplace([packaged]() { (*packaged)(); });
+        }
+        m_wake.notify_one();
+        return future;
+    }
+
+    size_t size() const { return m_workers.size(); }
+};
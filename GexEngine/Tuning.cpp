@@ -0,0 +1,78 @@
+#include "Tuning.h"
+#include "Assets.h"
+#include <algorithm>
+
+namespace {
+    // particle counts size pools and scratch buffers, so a typo in config.txt
+    // must not turn into a negative or multi-gigabyte allocation
+    const int MaxParticles = 65536;
+
+    float read(const Assets& assets, const TuningKey<float>& key) {
+        return assets.getFloat(key.name, key.fallback);
+    }
+
+    int read(const Assets& assets, const TuningKey<int>& key) {
+        return assets.getInt(key.name, key.fallback);
+    }
+
+    int read(const Assets& assets, const TuningKey<int>& key, int min, int max) {
+        return std::clamp(read(assets, key), min, max);
+    }
+
+    sf::Vector2f read(const Assets& assets, const TuningKey<sf::Vector2f>& key) {
+        return assets.getVector(key.name, key.fallback);
+    }
+}
+
+Tuning Tuning::resolve(const Assets& assets) {
+    using namespace TuningKeys;
+
+    Tuning t;
+    t.dogSpeed = read(assets, DogSpeed);
+    t.carSpeed = read(assets, CarSpeed);
+    t.backgroundScrollSpeed = read(assets, BackgroundScrollSpeed);
+    t.leftBoundary = read(assets, LeftBoundary);
+    t.winDistance = read(assets, WinDistance);
+
+    t.carSpawnInterval = read(assets, CarSpawnInterval);
+    t.boneSpawnInterval = read(assets, BoneSpawnInterval);
+    t.cookieSpawnInterval = read(assets, CookieSpawnInterval);
+    t.requiredBones = read(assets, RequiredBones);
+    t.requiredCookies = read(assets, RequiredCookies);
+
+    t.dogHealth = read(assets, DogHealth);
+    t.invincibilityDuration = read(assets, InvincibilityDuration);
+    t.invincibilityFlashFrequency = read(assets, InvincibilityFlashFrequency);
+    t.heartScale = read(assets, HeartScale);
+    t.heartBasePosition = read(assets, HeartBasePosition);
+    t.heartSpacing = read(assets, HeartSpacing);
+
+    t.hitAnimationDuration = read(assets, HitAnimationDuration);
+    t.hitForce = read(assets, HitForce);
+    t.hitRotationSpeed = read(assets, HitRotationSpeed);
+    t.hitTimeScale = read(assets, HitTimeScale);
+    t.timeScaleRecoveryRate = read(assets, TimeScaleRecoveryRate);
+    t.screenShakeIntensity = read(assets, ScreenShakeIntensity);
+    t.shakeDecayRate = read(assets, ShakeDecayRate);
+    t.flashAlpha = read(assets, FlashAlpha);
+    t.flashFadeRate = read(assets, FlashFadeRate);
+
+    t.particleGravity = read(assets, ParticleGravity);
+    t.impactParticleCount = read(assets, ImpactParticleCount, 0, MaxParticles);
+    t.impactParticleCapacity = read(assets, ImpactParticleCapacity, 0, MaxParticles);
+    t.particleFadeRate = read(assets, ParticleFadeRate);
+    t.confettiCount = read(assets, ConfettiCount, 0, MaxParticles);
+    return t;
+}
+
+std::shared_ptr<const Tuning> Tuning::current() {
+    static std::shared_ptr<const Tuning> snapshot;
+    static unsigned int revision = 0;
+
+    const auto& assets = Assets::getInstance();
+    if (!snapshot || revision != assets.getRevision()) {
+        snapshot = std::make_shared<const Tuning>(resolve(assets));
+        revision = assets.getRevision();
+    }
+    return snapshot;
+}
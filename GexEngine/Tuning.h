@@ -0,0 +1,97 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <memory>
+
+class Assets;
+
+// A config.txt key together with its type and the value used when the file
+// doesn't set it.
+template<typename T>
+struct TuningKey {
+    const char* name;
+    T           fallback;
+};
+
+namespace TuningKeys {
+    inline constexpr TuningKey<float>           DogSpeed{ "DogSpeed", 25.0f };
+    inline constexpr TuningKey<float>           CarSpeed{ "CarSpeed", 100.0f };
+    inline constexpr TuningKey<float>           BackgroundScrollSpeed{ "BackgroundScrollSpeed", 200.0f };
+    inline constexpr TuningKey<float>           LeftBoundary{ "LeftBoundary", 175.0f };
+    inline constexpr TuningKey<float>           WinDistance{ "WinDistance", 3000.0f };
+
+    inline constexpr TuningKey<float>           CarSpawnInterval{ "CarSpawnInterval", 1.5f };
+    inline constexpr TuningKey<float>           BoneSpawnInterval{ "BoneSpawnInterval", 3.0f };
+    inline constexpr TuningKey<float>           CookieSpawnInterval{ "CookieSpawnInterval", 4.0f };
+    inline constexpr TuningKey<int>             RequiredBones{ "RequiredBones", 10 };
+    inline constexpr TuningKey<int>             RequiredCookies{ "RequiredCookies", 10 };
+
+    inline constexpr TuningKey<int>             DogHealth{ "HitAnimation.DogHealth", 3 };
+    inline constexpr TuningKey<float>           InvincibilityDuration{ "HitAnimation.InvincibilityDuration", 2.0f };
+    inline constexpr TuningKey<int>             InvincibilityFlashFrequency{ "InvincibilityFlashFrequency", 8 };
+    inline constexpr TuningKey<float>           HeartScale{ "HeartScale", 0.05f };
+    inline const TuningKey<sf::Vector2f>        HeartBasePosition{ "HeartBasePosition", sf::Vector2f(20.f, 20.f) };   // sf::Vector2 isn't constexpr in SFML 2
+    inline constexpr TuningKey<float>           HeartSpacing{ "HeartSpacing", 40.f };
+
+    inline constexpr TuningKey<float>           HitAnimationDuration{ "HitAnimation.Duration", 2.0f };
+    inline constexpr TuningKey<float>           HitForce{ "HitForce", 300.0f };
+    inline constexpr TuningKey<float>           HitRotationSpeed{ "HitRotationSpeed", 360.0f };
+    inline constexpr TuningKey<float>           HitTimeScale{ "HitTimeScale", 0.5f };
+    inline constexpr TuningKey<float>           TimeScaleRecoveryRate{ "TimeScaleRecoveryRate", 0.5f };
+    inline constexpr TuningKey<float>           ScreenShakeIntensity{ "ScreenShakeIntensity", 10.0f };
+    inline constexpr TuningKey<float>           ShakeDecayRate{ "ShakeDecayRate", 20.0f };
+    inline constexpr TuningKey<int>             FlashAlpha{ "FlashAlpha", 180 };
+    inline constexpr TuningKey<int>             FlashFadeRate{ "FlashFadeRate", 5 };
+
+    inline constexpr TuningKey<float>           ParticleGravity{ "HitAnimation.ParticleGravity", 200.0f };
+    inline constexpr TuningKey<int>             ImpactParticleCount{ "ImpactParticleCount", 20 };
+    inline constexpr TuningKey<int>             ImpactParticleCapacity{ "ImpactParticleCapacity", 512 };
+    inline constexpr TuningKey<int>             ParticleFadeRate{ "ParticleFadeRate", 2 };
+    inline constexpr TuningKey<int>             ConfettiCount{ "ConfettiCount", 200 };
+}
+
+// Every gameplay value Scene_Game reads, looked up from Assets once so the
+// per-frame code only touches plain fields. Add a key above, a field here
+// and a line in resolve() for a new knob.
+struct Tuning {
+    float           dogSpeed;
+    float           carSpeed;
+    float           backgroundScrollSpeed;
+    float           leftBoundary;
+    float           winDistance;
+
+    float           carSpawnInterval;
+    float           boneSpawnInterval;
+    float           cookieSpawnInterval;
+    int             requiredBones;
+    int             requiredCookies;
+
+    int             dogHealth;
+    float           invincibilityDuration;
+    int             invincibilityFlashFrequency;
+    float           heartScale;
+    sf::Vector2f    heartBasePosition;
+    float           heartSpacing;
+
+    float           hitAnimationDuration;
+    float           hitForce;
+    float           hitRotationSpeed;
+    float           hitTimeScale;
+    float           timeScaleRecoveryRate;
+    float           screenShakeIntensity;
+    float           shakeDecayRate;
+    int             flashAlpha;
+    int             flashFadeRate;
+
+    float           particleGravity;
+    int             impactParticleCount;
+    int             impactParticleCapacity;
+    int             particleFadeRate;
+    int             confettiCount;
+
+    static Tuning resolve(const Assets& assets);
+
+    // Immutable snapshot of the current values. A new one is built the first
+    // time it's asked for after Assets reloaded config.txt; holders of an
+    // older one keep reading it until they ask again.
+    static std::shared_ptr<const Tuning> current();
+};
@@ -1,13 +1,161 @@
-
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
+#include <filesystem>
+#include <string>
+#include <thread>
 #include "GameEngine.h"
-#include "Scene_Title.h"
+#include "Scene_Game.h"
+#include "Scene_Loading.h"
+
+namespace {
+    struct HeadlessOptions {
+        std::string     script;
+        int             runs{ 1 };
+        std::uint64_t   maxTicks{ 60 * 60 * 10 };     // ten simulated minutes
+        std::uint64_t   seed{ 0 };                    // 0 keeps the engine's seed
+    };
+
+
+    // Plays Scene_Game start to finish the given number of times, without a
+    // window, driven by the script (or W held down when there is none).
+    int runHeadless(const std::string& configPath, const HeadlessOptions& options) {
+        GameEngine game(configPath, true);
+
+        auto input = std::make_unique<ScriptedInput>();
+        if (options.script.empty())
+            input->addStep(0, sf::Keyboard::W, true);
+        else if (!input->loadFromFile(options.script))
+            return 1;
+        ScriptedInput& script = *input;
+        game.setInputSource(std::move(input));
+
+        while (!Assets::getInstance().isLoaded()) {
+            Assets::getInstance().update();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        // run n is session n, seed + n, and replays alone with --seed <that> --runs 1
+        if (options.seed != 0)
+            game.random().setSeed(options.seed);
+
+        int wins = 0;
+        std::uint64_t totalTicks = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int run = 0; run < options.runs && game.isRunning(); ++run) {
+            script.rewind();
+            auto scene = std::make_shared<Scene_Game>(&game);
+            game.changeScene("GAME", scene, true);
+
+            std::uint64_t ticks = game.simulate(options.maxTicks);
+            totalTicks += ticks;
+            wins += scene->isWin() ? 1 : 0;
+
+            std::cout << "Run " << run + 1 << " (seed " << scene->getSeed() << "): "
+                << (scene->isWin() ? "win" : scene->hasEnded() ? "game over" : "timed out")
+                << " after " << ticks << " ticks, distance " << scene->getDistance() << "\n";
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << options.runs << " runs, " << wins << " wins, " << totalTicks << " ticks in "
+            << elapsed.count() << "s (" << totalTicks / std::max(elapsed.count(), 1e-6) << " ticks/s)" << std::endl;
+        return 0;
+    }
+
+
+    // Plays a journal written by --record back at full speed, without a
+    // window, and reports where the session ended up.
+    int runReplay(const std::string& configPath, const std::string& journalPath) {
+        InputJournal journal;
+        if (!journal.load(journalPath))
+            return 1;
 
-int main()
+        GameEngine game(configPath, true);
+        game.setInputSource(std::make_unique<JournalPlayer>(journal));
+        game.random().setSeed(journal.getSeed());
+
+        // spawns and bounds depend on the viewport, so play in the recorded one
+        sf::Vector2u viewport = journal.getViewport();
+        if (viewport.x > 0 && viewport.y > 0)
+            game.setViewport(sf::Vector2f(viewport));
+
+        while (!Assets::getInstance().isLoaded()) {
+            Assets::getInstance().update();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        auto scene = std::make_shared<Scene_Game>(&game);
+        game.changeScene("GAME", scene, true);
+
+        // past game over as well, the player may have restarted
+        std::uint64_t ticks = game.simulate(journal.getTickCount(), false);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << "Replayed " << ticks << " of " << journal.getTickCount() << " ticks (seed " << journal.getSeed()
+            << ") in " << elapsed.count() << "s: "
+            << (scene->isWin() ? "win" : scene->hasEnded() ? "game over" : "still playing")
+            << ", distance " << scene->getDistance() << std::endl;
+        return ticks == journal.getTickCount() ? 0 : 1;
+    }
+}
+
+
+// GexEngine [--record file] [--speed n] [--render-every n]
+//           [--replay file]
+//           [--headless [--script file] [--runs n] [--ticks n] [--seed n]]
+int main(int argc, char* argv[])
 {
-    GameEngine game("../config.txt");
-    game.changeScene("TITLE", std::make_shared<Scene_Title>(&game));
+    // a pack baked by AssetPacker replaces config.txt and the loose files in ../assets
+    const std::string packPath = "../assets.pack";
+    const std::string configPath = std::filesystem::exists(packPath) ? packPath : "../config.txt";
+
+    bool headless = false;
+    HeadlessOptions options;
+    std::string recordPath, replayPath;
+    int speed = -1, renderEvery = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--headless")
+            headless = true;
+        else if (arg == "--script" && i + 1 < argc)
+            options.script = argv[++i];
+        else if (arg == "--runs" && i + 1 < argc)
+            options.runs = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--ticks" && i + 1 < argc)
+            options.maxTicks = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--seed" && i + 1 < argc)
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--record" && i + 1 < argc)
+            recordPath = argv[++i];
+        else if (arg == "--replay" && i + 1 < argc)
+            replayPath = argv[++i];
+        else if (arg == "--speed" && i + 1 < argc)
+            speed = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--render-every" && i + 1 < argc)
+            renderEvery = std::max(1, std::atoi(argv[++i]));
+        else {
+            std::cerr << "Unknown argument " << arg << "\n"
+                << "Usage: GexEngine [--record file] [--speed n] [--render-every n] [--replay file]"
+                << " [--headless [--script file] [--runs n] [--ticks n] [--seed n]]\n";
+            return 1;
+        }
+    }
+
+    if (!replayPath.empty())
+        return runReplay(configPath, replayPath);
+    if (headless)
+        return runHeadless(configPath, options);
+
+    GameEngine game(configPath);
+    if (!recordPath.empty())
+        game.startRecording(recordPath);
+    if (speed >= 0)
+        game.setSimulationSpeed(static_cast<size_t>(speed));
+    if (renderEvery > 0)
+        game.setRenderInterval(static_cast<size_t>(renderEvery));
+    game.changeScene("LOADING", std::make_shared<Scene_Loading>(&game));
     game.run();
     return 0;
 }
-
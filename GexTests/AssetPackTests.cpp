@@ -0,0 +1,101 @@
+#include "Check.h"
+#include "../GexEngine/AssetPack.h"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+    const std::string Config = "WindowSize 1280 768\nTexture dog ../assets/dog.png\n";
+    const std::uint8_t Pixels[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24 };
+    const std::int16_t Samples[] = { 0, 1000, -1000, 32767, -32768 };
+
+    bool writePack(const std::string& path) {
+        AssetPackWriter writer;
+        if (!writer.open(path))
+            return false;
+        writer.add(AssetPack::Type::Config, AssetPackFormat::ConfigName, Config.data(), Config.size());
+        writer.add(AssetPack::Type::Texture, "../assets/dog.png", Pixels, sizeof(Pixels), 3, 2);
+        writer.add(AssetPack::Type::Sound, "../assets/bark.wav", Samples, sizeof(Samples), 1, 22050);
+        return writer.getEntryCount() == 3 && writer.finish();
+    }
+
+    // copy of the pack without its last bytes
+    std::string truncatedCopy(const std::string& path, std::uintmax_t cut) {
+        std::string target = path + ".cut";
+        std::filesystem::copy_file(path, target, std::filesystem::copy_options::overwrite_existing);
+        std::filesystem::resize_file(target, std::filesystem::file_size(path) - cut);
+        return target;
+    }
+
+    void testRoundTrip(const std::string& path) {
+        CHECK(AssetPack::isPack(path));
+
+        AssetPack pack;
+        if (!CHECK(pack.open(path)))
+            return;
+
+        const auto* config = pack.find(AssetPack::Type::Config, AssetPackFormat::ConfigName);
+        if (CHECK(config)) {
+            CHECK(config->size == Config.size());
+            CHECK(std::memcmp(pack.data(*config), Config.data(), Config.size()) == 0);
+        }
+
+        const auto* texture = pack.find(AssetPack::Type::Texture, "../assets/dog.png");
+        if (CHECK(texture)) {
+            CHECK(texture->param0 == 3 && texture->param1 == 2);
+            CHECK(texture->size == sizeof(Pixels));
+            CHECK(std::memcmp(pack.data(*texture), Pixels, sizeof(Pixels)) == 0);
+        }
+
+        const auto* sound = pack.find(AssetPack::Type::Sound, "../assets/bark.wav");
+        if (CHECK(sound)) {
+            CHECK(sound->param0 == 1 && sound->param1 == 22050);
+            CHECK(std::memcmp(pack.data(*sound), Samples, sizeof(Samples)) == 0);
+        }
+
+        // payloads are read in place, so every one starts aligned
+        for (const auto* entry : { config, texture, sound }) {
+            if (entry)
+                CHECK(entry->offset % AssetPackFormat::Alignment == 0);
+        }
+
+        // found by name and type together
+        CHECK(!pack.find(AssetPack::Type::Sound, "../assets/dog.png"));
+        CHECK(!pack.find(AssetPack::Type::Texture, "../assets/cat.png"));
+
+        pack.close();
+        CHECK(!pack.isOpen());
+    }
+
+    void testRejectsDamage(const std::string& path) {
+        // a text config isn't a pack
+        std::string configPath = tempPath("config.txt");
+        std::ofstream(configPath) << Config;
+        CHECK(!AssetPack::isPack(configPath));
+        AssetPack pack;
+        CHECK(!pack.open(configPath));
+
+        // cut into the index, then into the payloads
+        for (std::uintmax_t cut : { 5, 40 }) {
+            std::string truncated = truncatedCopy(path, cut);
+            CHECK(!pack.open(truncated));
+            CHECK(!pack.isOpen());
+            std::filesystem::remove(truncated);
+        }
+        std::filesystem::remove(configPath);
+    }
+}
+
+
+void runAssetPackTests() {
+    std::string path = tempPath("assets.pack");
+    if (!CHECK(writePack(path)))
+        return;
+
+    testRoundTrip(path);
+    testRejectsDamage(path);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+// Just enough of a test framework for GexTests: CHECK reports the failing
+// expression and carries on, main() exits non-zero if anything failed.
+inline int& checkFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+inline bool check(bool ok, const char* expression, const char* file, int line) {
+    if (!ok) {
+        std::cerr << file << ":" << line << ": CHECK(" << expression << ") failed\n";
+        ++checkFailures();
+    }
+    return ok;
+}
+
+#define CHECK(expression) check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
+
+// scratch file for tests that write to disk
+inline std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("GexTests_" + name)).string();
+}
+
+// one per source file, called from main.cpp
+void runSchedulerTests();
+void runAssetPackTests();
+void runScriptedInputTests();
+void runRandomTests();
+void runInputJournalTests();
@@ -0,0 +1,169 @@
+#include "Check.h"
+#include "../GexEngine/InputJournal.h"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+    using Events = std::vector<InputSource::KeyEvent>;
+
+    std::string readBytes(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void writeBytes(const std::string& path, const std::string& bytes) {
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+    }
+
+    bool sameRuns(const InputJournal& a, const InputJournal& b) {
+        if (a.getRuns().size() != b.getRuns().size())
+            return false;
+        for (size_t i = 0; i < a.getRuns().size(); ++i) {
+            if (a.getRuns()[i].mask != b.getRuns()[i].mask || a.getRuns()[i].length != b.getRuns()[i].length)
+                return false;
+        }
+        return true;
+    }
+
+    void testRunLength() {
+        InputJournal journal;
+        journal.clear(1);
+        for (int i = 0; i < 1000; ++i)
+            journal.append(5);
+        CHECK(journal.getRuns().size() == 1);
+        CHECK(journal.getRuns()[0].length == 1000);
+
+        for (std::uint32_t mask : { 1u, 1u, 1u, 2u, 0u, 0u })
+            journal.append(mask);
+        CHECK(journal.getTickCount() == 1006);
+        CHECK(journal.getRuns().size() == 4);
+        CHECK(journal.getRuns()[1].mask == 1 && journal.getRuns()[1].length == 3);
+    }
+
+    void testRoundTrip(const std::string& path) {
+        InputJournal journal;
+        journal.clear(99, sf::Vector2u(800, 600));
+        for (std::uint32_t mask : { 1u, 1u, 1u, 2u, 0u, 0u, 3u })
+            journal.append(mask);
+        if (!CHECK(journal.save(path)))
+            return;
+
+        InputJournal loaded;
+        if (!CHECK(loaded.load(path)))
+            return;
+        CHECK(loaded.getSeed() == 99);
+        CHECK(loaded.getViewport() == sf::Vector2u(800, 600));
+        CHECK(loaded.getTickCount() == 7);
+        CHECK(sameRuns(journal, loaded));
+    }
+
+    void testRejectsDamage(const std::string& path) {
+        const std::string bytes = readBytes(path);
+        InputJournal journal;
+
+        // cut inside the runs, then inside the header
+        for (size_t cut : { size_t(4), bytes.size() - 10 }) {
+            writeBytes(path + ".cut", bytes.substr(0, bytes.size() - cut));
+            CHECK(!journal.load(path + ".cut"));
+            CHECK(journal.getTickCount() == 0 && journal.getRuns().empty());
+        }
+
+        // the tick count must match the runs
+        std::string patched = bytes;
+        patched[8 + 4 + 8 + 8] ^= 1;
+        writeBytes(path + ".cut", patched);
+        CHECK(!journal.load(path + ".cut"));
+
+        patched = bytes;
+        patched[8] = 9;     // version
+        writeBytes(path + ".cut", patched);
+        CHECK(!journal.load(path + ".cut"));
+
+        std::filesystem::remove(path + ".cut");
+        CHECK(!journal.load(tempPath("missing.jrnl")));
+    }
+
+    // version 1 had no viewport after the seed
+    void testLoadsVersionOne(const std::string& path) {
+        std::string bytes = readBytes(path);
+        bytes.erase(8 + 4 + 8, 8);
+        bytes[8] = 1;
+        writeBytes(path + ".v1", bytes);
+
+        InputJournal journal;
+        if (CHECK(journal.load(path + ".v1"))) {
+            CHECK(journal.getSeed() == 99);
+            CHECK(journal.getViewport() == sf::Vector2u(0, 0));
+            CHECK(journal.getTickCount() == 7);
+        }
+        std::filesystem::remove(path + ".v1");
+    }
+
+    void testPlayback() {
+        const auto& keys = InputJournal::keys();
+        InputJournal journal;
+        journal.clear(1);
+        for (std::uint32_t mask : { 1u, 1u, 2u })
+            journal.append(mask);
+
+        // the key held on the first tick was pressed before the session began
+        JournalPlayer player(journal);
+        Events events;
+        player.poll(events);
+        CHECK(events.empty());
+        CHECK(player.isKeyPressed(keys[0]));
+
+        player.poll(events);
+        CHECK(events.empty());
+
+        player.poll(events);
+        CHECK(events.size() == 2);
+        if (events.size() == 2) {
+            CHECK(events[0].key == keys[0] && !events[0].pressed);
+            CHECK(events[1].key == keys[1] && events[1].pressed);
+        }
+        CHECK(player.isFinished());
+
+        // every key is up once the journal runs out
+        events.clear();
+        player.poll(events);
+        CHECK(events.size() == 1 && events[0].key == keys[1] && !events[0].pressed);
+        CHECK(!player.isKeyPressed(keys[1]));
+
+        player.rewind();
+        CHECK(!player.isFinished());
+        CHECK(player.isKeyPressed(keys[0]));
+    }
+
+    void testDiff() {
+        const auto& keys = InputJournal::keys();
+        Events events;
+        InputJournal::diff(0b101, 0b110, events);
+        CHECK(events.size() == 2);
+        if (events.size() == 2) {
+            CHECK(events[0].key == keys[0] && !events[0].pressed);
+            CHECK(events[1].key == keys[1] && events[1].pressed);
+        }
+
+        events.clear();
+        InputJournal::diff(7, 7, events);
+        CHECK(events.empty());
+    }
+}
+
+
+void runInputJournalTests() {
+    std::string path = tempPath("session.jrnl");
+    testRunLength();
+    testRoundTrip(path);
+    testRejectsDamage(path);
+    testLoadsVersionOne(path);
+    testPlayback();
+    testDiff();
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,153 @@
+#include "Check.h"
+#include "../GexEngine/Scheduler.h"
+#include <string>
+#include <vector>
+
+namespace {
+    void testOrdering() {
+        Scheduler scheduler;
+        std::string fired;
+        scheduler.after(sf::milliseconds(30), [&] { fired += "a"; });
+        scheduler.after(sf::milliseconds(10), [&] { fired += "b"; });
+        scheduler.after(sf::milliseconds(10), [&] { fired += "c"; });     // same deadline, armed later
+
+        scheduler.advance(sf::milliseconds(9));
+        CHECK(fired.empty());
+        scheduler.advance(sf::milliseconds(41));
+        CHECK(fired == "bca");
+    }
+
+    void testCatchUp() {
+        Scheduler scheduler;
+        std::vector<sf::Int64> firedAt;
+        scheduler.every(sf::milliseconds(10), [&] { firedAt.push_back(scheduler.now().asMicroseconds()); });
+
+        // one long step fires every interval it covers, each at its own deadline
+        scheduler.advance(sf::milliseconds(35));
+        CHECK(firedAt == std::vector<sf::Int64>({ 10000, 20000, 30000 }));
+        CHECK(scheduler.now() == sf::milliseconds(35));
+
+        scheduler.advance(sf::milliseconds(5));
+        CHECK(firedAt.size() == 4);
+    }
+
+    void testRestart() {
+        Scheduler scheduler;
+        int count = 0;
+        auto id = scheduler.every(sf::milliseconds(10), [&] { ++count; });
+
+        scheduler.advance(sf::milliseconds(8));
+        scheduler.restart(id);
+        scheduler.advance(sf::milliseconds(8));
+        CHECK(count == 0);
+        scheduler.advance(sf::milliseconds(2));
+        CHECK(count == 1);
+        CHECK(scheduler.isActive(id));
+    }
+
+    void testSetInterval() {
+        Scheduler scheduler;
+        int count = 0;
+        auto id = scheduler.every(sf::milliseconds(10), [&] { ++count; });
+
+        // counts from when the timer was armed, not from the call
+        scheduler.advance(sf::milliseconds(5));
+        scheduler.setInterval(id, sf::milliseconds(20));
+        scheduler.advance(sf::milliseconds(14));
+        CHECK(count == 0);
+        scheduler.advance(sf::milliseconds(1));
+        CHECK(count == 1);
+        scheduler.advance(sf::milliseconds(20));
+        CHECK(count == 2);
+    }
+
+    void testCancel() {
+        Scheduler scheduler;
+        int count = 0;
+        auto id = scheduler.after(sf::milliseconds(10), [&] { ++count; });
+        CHECK(scheduler.isActive(id));
+        scheduler.cancel(id);
+        CHECK(!scheduler.isActive(id));
+        scheduler.advance(sf::milliseconds(20));
+        CHECK(count == 0);
+
+        // a one-shot is finished once it fired, cancelling it is a no-op
+        auto once = scheduler.after(sf::milliseconds(10), [&] { ++count; });
+        scheduler.advance(sf::milliseconds(10));
+        CHECK(count == 1);
+        CHECK(!scheduler.isActive(once));
+        scheduler.cancel(once);
+        scheduler.cancel(Scheduler::TimerId{});
+    }
+
+    void testSelfCancel() {
+        Scheduler scheduler;
+        int count = 0;
+        Scheduler::TimerId id;
+        id = scheduler.every(sf::milliseconds(10), [&] {
+            if (++count == 2)
+                scheduler.cancel(id);
+            });
+
+        scheduler.advance(sf::milliseconds(100));
+        CHECK(count == 2);
+        CHECK(!scheduler.isActive(id));
+
+        // the freed slot is reused without the old id reaching the new timer
+        int other = 0;
+        auto next = scheduler.every(sf::milliseconds(10), [&] { ++other; });
+        CHECK(next.index == id.index);
+        scheduler.cancel(id);
+        scheduler.advance(sf::milliseconds(10));
+        CHECK(other == 1);
+    }
+
+    void testClearKeepsIdsApart() {
+        Scheduler scheduler;
+        int oldCount = 0;
+        int newCount = 0;
+        auto old = scheduler.every(sf::milliseconds(10), [&] { ++oldCount; });
+        scheduler.clear();
+        CHECK(!scheduler.isActive(old));
+        CHECK(scheduler.now() == sf::Time::Zero);
+
+        auto fresh = scheduler.every(sf::milliseconds(10), [&] { ++newCount; });
+        scheduler.cancel(old);
+        CHECK(scheduler.isActive(fresh));
+        scheduler.advance(sf::milliseconds(10));
+        CHECK(oldCount == 0);
+        CHECK(newCount == 1);
+    }
+
+    // the same game time at different tick rates fires the same number of times
+    int firingsOver(int ticksPerSecond, float seconds) {
+        Scheduler scheduler;
+        int count = 0;
+        scheduler.every(sf::milliseconds(250), [&] { ++count; });
+        scheduler.after(sf::seconds(1.5f), [&] { ++count; });
+
+        const sf::Time dt = sf::seconds(1.f / ticksPerSecond);
+        for (int tick = 0; tick < static_cast<int>(seconds * ticksPerSecond); ++tick)
+            scheduler.advance(dt);
+        return count;
+    }
+
+    void testTickRateIndependence() {
+        int at60 = firingsOver(60, 10.f);
+        int at240 = firingsOver(240, 10.f);
+        CHECK(at60 == 40);
+        CHECK(at60 == at240);
+    }
+}
+
+
+void runSchedulerTests() {
+    testOrdering();
+    testCatchUp();
+    testRestart();
+    testSetInterval();
+    testCancel();
+    testSelfCancel();
+    testClearKeepsIdsApart();
+    testTickRateIndependence();
+}
@@ -0,0 +1,91 @@
+#include "Check.h"
+#include "../GexEngine/InputSource.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+    using Events = std::vector<InputSource::KeyEvent>;
+
+    bool isEvent(const InputSource::KeyEvent& event, sf::Keyboard::Key key, bool pressed) {
+        return event.key == key && event.pressed == pressed;
+    }
+
+    void testTickOrder() {
+        // added out of order; steps on one tick keep the order they were added in
+        ScriptedInput input;
+        input.addStep(5, sf::Keyboard::W, true);
+        input.addStep(0, sf::Keyboard::A, true);
+        input.addStep(5, sf::Keyboard::A, false);
+
+        Events events;
+        input.poll(events);
+        CHECK(events.size() == 1 && isEvent(events[0], sf::Keyboard::A, true));
+        CHECK(input.isKeyPressed(sf::Keyboard::A));
+
+        for (int tick = 1; tick < 5; ++tick) {
+            events.clear();
+            input.poll(events);
+            CHECK(events.empty());
+        }
+
+        events.clear();
+        input.poll(events);
+        CHECK(events.size() == 2 && isEvent(events[0], sf::Keyboard::W, true) && isEvent(events[1], sf::Keyboard::A, false));
+        CHECK(input.isKeyPressed(sf::Keyboard::W));
+        CHECK(!input.isKeyPressed(sf::Keyboard::A));
+
+        // the same script again from tick 0 with every key up
+        input.rewind();
+        CHECK(!input.isKeyPressed(sf::Keyboard::W));
+        events.clear();
+        input.poll(events);
+        CHECK(events.size() == 1 && isEvent(events[0], sf::Keyboard::A, true));
+    }
+
+    void testKeyNames() {
+        CHECK(ScriptedInput::keyFromName("W") == sf::Keyboard::W);
+        CHECK(ScriptedInput::keyFromName("7") == sf::Keyboard::Num7);
+        CHECK(ScriptedInput::keyFromName("F1") == sf::Keyboard::F1);
+        CHECK(ScriptedInput::keyFromName("F12") == sf::Keyboard::F12);
+        CHECK(ScriptedInput::keyFromName("Space") == sf::Keyboard::Space);
+        CHECK(ScriptedInput::keyFromName("F13") == sf::Keyboard::Unknown);
+        CHECK(ScriptedInput::keyFromName("w") == sf::Keyboard::Unknown);
+        CHECK(ScriptedInput::keyFromName("") == sf::Keyboard::Unknown);
+
+        for (auto key : { sf::Keyboard::Q, sf::Keyboard::Num0, sf::Keyboard::F9, sf::Keyboard::Left, sf::Keyboard::Escape })
+            CHECK(ScriptedInput::keyFromName(ScriptedInput::keyName(key)) == key);
+        CHECK(ScriptedInput::keyName(sf::Keyboard::Tab) == "Unknown");
+    }
+
+    bool loadScript(ScriptedInput& input, const std::string& text) {
+        std::string path = tempPath("script.txt");
+        std::ofstream(path) << text;
+        bool loaded = input.loadFromFile(path);
+        std::filesystem::remove(path);
+        return loaded;
+    }
+
+    void testLoading() {
+        ScriptedInput input;
+        CHECK(loadScript(input, "# hold W for two ticks\n\n0 press W\n2 release W\n"));
+        Events events;
+        for (int tick = 0; tick < 3; ++tick)
+            input.poll(events);
+        CHECK(events.size() == 2 && isEvent(events[0], sf::Keyboard::W, true) && isEvent(events[1], sf::Keyboard::W, false));
+
+        CHECK(!loadScript(input, "0 hold W\n"));
+        CHECK(!loadScript(input, "0 press Banana\n"));
+        CHECK(!loadScript(input, "soon press W\n"));
+        CHECK(!loadScript(input, "0 press\n"));
+        CHECK(!input.loadFromFile(tempPath("missing.txt")));
+    }
+}
+
+
+void runScriptedInputTests() {
+    testTickOrder();
+    testKeyNames();
+    testLoading();
+}
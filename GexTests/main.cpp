@@ -0,0 +1,32 @@
+#include "Check.h"
+
+// Unit tests for the engine pieces that don't need a window or an audio
+// device. Run from the GexTests directory; exits 1 on any failed CHECK.
+int main()
+{
+    struct Suite {
+        const char* name;
+        void (*run)();
+    };
+
+    const Suite suites[] = {
+        { "Scheduler", runSchedulerTests },
+        { "AssetPack", runAssetPackTests },
+        { "ScriptedInput", runScriptedInputTests },
+        { "Random", runRandomTests },
+        { "InputJournal", runInputJournalTests },
+    };
+
+    for (const auto& suite : suites) {
+        int before = checkFailures();
+        suite.run();
+        std::cout << suite.name << ": " << (checkFailures() == before ? "ok" : "FAILED") << std::endl;
+    }
+
+    if (checkFailures() > 0) {
+        std::cerr << checkFailures() << " checks failed\n";
+        return 1;
+    }
+    std::cout << "All tests passed" << std::endl;
+    return 0;
+}